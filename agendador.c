@@ -0,0 +1,114 @@
+#include <string.h>
+
+#include "agendador.h"
+#include "buzzer.h"
+#include "registro.h"
+#include "telemetria.h"
+
+static const uint32_t limites_faixas[AGENDADOR_FAIXAS - 1] = AGENDADOR_LIMITES_FAIXAS;
+
+static alarm_pool_t *pool_agendador;
+
+// Uma tarefa por camada do compositor, cada uma com o seu alarme
+static Tarefa tarefas[NUM_CAMADAS];
+static volatile alarm_id_t alarmes[NUM_CAMADAS];
+
+// Instante absoluto em que o passo atual de cada tarefa deveria ter começado
+static absolute_time_t prazos[NUM_CAMADAS];
+static EstatisticasQuadro estatisticas;
+
+static void registrar_atraso(int64_t atraso_us) {
+    if (atraso_us < 0) {
+        atraso_us = 0;
+    }
+    int faixa = 0;
+    while (faixa < AGENDADOR_FAIXAS - 1 && atraso_us > limites_faixas[faixa]) {
+        faixa++;
+    }
+    estatisticas.faixas[faixa]++;
+    estatisticas.quadros++;
+    if (atraso_us > estatisticas.atraso_max_us) {
+        estatisticas.atraso_max_us = atraso_us;
+    }
+}
+
+// Executa um passo da tarefa. O retorno negativo reagenda o alarme em relação
+// ao horário em que ele deveria ter disparado, e não ao fim do passo, então o
+// tempo de render não se acumula de um quadro para o outro.
+static int64_t alarme_passo(alarm_id_t id, void *user_data) {
+    Camada camada = (Camada)(uintptr_t)user_data;
+    int64_t atraso = absolute_time_diff_us(prazos[camada], get_absolute_time());
+    registrar_atraso(atraso);
+
+    uint32_t inicio_us = time_us_32();
+    int64_t proximo = tarefas[camada].passo(&tarefas[camada]);
+    telemetria_render(inicio_us);
+    if (proximo <= 0) {
+        alarmes[camada] = 0;
+        return 0;
+    }
+
+    // Atrasado por mais de um quadro (por exemplo, interrupções longas): em vez
+    // de disparar vários quadros seguidos para recuperar, recomeça a contagem
+    if (atraso > proximo) {
+        estatisticas.estouros++;
+        prazos[camada] = make_timeout_time_us(proximo);
+        return proximo;
+    }
+
+    prazos[camada] = delayed_by_us(prazos[camada], proximo);
+    return -proximo;
+}
+
+void agendador_init(alarm_pool_t *pool) {
+    pool_agendador = pool;
+}
+
+void agendador_iniciar(Tarefa tarefa) {
+    Camada camada = tarefa.camada;
+    agendador_parar_camada(camada);
+    buzzer_parar();
+    tarefa.frame = 0;
+    tarefas[camada] = tarefa;
+
+    // O primeiro passo roda já, os seguintes ficam a cargo do alarme
+    prazos[camada] = get_absolute_time();
+    alarm_id_t id = alarm_pool_add_alarm_at(pool_agendador, prazos[camada], alarme_passo,
+                                            (void *)(uintptr_t)camada, true);
+    if (id < 0) {
+        registro("Erro ao agendar animação.\n");
+        return;
+    }
+    alarmes[camada] = id;
+}
+
+void agendador_parar_camada(Camada camada) {
+    if (alarmes[camada] > 0) {
+        alarm_pool_cancel_alarm(pool_agendador, alarmes[camada]);
+        alarmes[camada] = 0;
+    }
+}
+
+void agendador_parar(void) {
+    for (int c = 0; c < NUM_CAMADAS; c++) {
+        agendador_parar_camada(c);
+    }
+    buzzer_parar();
+}
+
+bool agendador_ativo(void) {
+    for (int c = 0; c < NUM_CAMADAS; c++) {
+        if (alarmes[c] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void agendador_estatisticas(EstatisticasQuadro *copia) {
+    memcpy(copia, &estatisticas, sizeof(estatisticas));
+}
+
+void agendador_zerar_estatisticas(void) {
+    memset(&estatisticas, 0, sizeof(estatisticas));
+}
@@ -0,0 +1,66 @@
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include "pico/stdlib.h"
+
+#include "animacoes.h"
+#include "compositor.h"
+
+typedef struct Tarefa Tarefa;
+
+// Desenha o passo atual da tarefa e retorna a duração dele, em µs: o próximo
+// passo começa nesse tempo após o prazo deste. Retornar 0 encerra a tarefa.
+typedef int64_t (*passo_t)(Tarefa *t);
+
+// Animação em execução, avançada um quadro por vez pelos alarmes do agendador.
+// Há uma tarefa por camada do compositor, e cada uma desenha na sua.
+struct Tarefa {
+    passo_t passo;
+    Camada camada;
+    const Animacao *anim;
+    const LinhaTempo *linha;   // Passos da linha do tempo em execução, se houver
+    const Texto *texto;        // Mensagem rolando, se houver
+    int frame;
+    int subquadro, subquadros; // Quadro intermediário atual e total no quadro-chave
+    bool sem_transicao;        // Transição desligada por estourar o orçamento
+    int buzzer_freq, buzzer_duration;
+    uint8_t r2, g2, b2; // Segunda cor (animação multicolorida)
+};
+
+// Número de faixas do histograma de atraso dos quadros
+#define AGENDADOR_FAIXAS 6
+
+// Limite superior (µs) de cada faixa; a última faixa recebe tudo acima do
+// último limite
+#define AGENDADOR_LIMITES_FAIXAS { 10, 50, 100, 500, 1000 }
+
+// Pontualidade dos quadros: atraso de cada passo em relação ao prazo absoluto.
+// Faixas: até 10 µs, 50 µs, 100 µs, 500 µs, 1 ms e acima de 1 ms.
+typedef struct {
+    uint32_t faixas[AGENDADOR_FAIXAS];
+    uint32_t quadros;
+    uint32_t estouros;      // Passos que perderam o prazo por mais de um quadro
+    uint32_t atraso_max_us;
+} EstatisticasQuadro;
+
+// Usa o alarm pool informado para disparar os passos das tarefas
+void agendador_init(alarm_pool_t *pool);
+
+// Interrompe a tarefa da mesma camada (se houver) e o som, e começa a nova
+// imediatamente. As tarefas das outras camadas continuam.
+void agendador_iniciar(Tarefa tarefa);
+
+// Interrompe só a tarefa da camada, sem mexer no som nem no quadro
+void agendador_parar_camada(Camada camada);
+
+// Interrompe todas as tarefas e o som, mantendo o último quadro na matriz
+void agendador_parar(void);
+
+// Indica se há alguma tarefa em execução
+bool agendador_ativo(void);
+
+// Copia o histograma de pontualidade acumulado desde o último zerar
+void agendador_estatisticas(EstatisticasQuadro *copia);
+void agendador_zerar_estatisticas(void);
+
+#endif
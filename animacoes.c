@@ -0,0 +1,343 @@
+#include "animacoes.h"
+
+// Intensidades em 8 bits (0 = apagado, 255 = 100%), convertidas dos valores
+// 0.0-1.0 originais, linha a linha como aparecem na matriz (layout.h). Tudo
+// é const e fica na flash (XIP), sem ocupar SRAM.
+// As animações 6 e 9 ficam comprimidas em fluxos/ (ver fluxo.h) e as
+// animações 0, 1, 3 e 4 são calculadas quadro a quadro (ver gerador.h).
+
+// Gradiente: onda senoidal na diagonal, uma volta a cada 10 pixels e a cada 10 quadros
+static const Gerador gerador_animacao_0 = {
+    .funcao = gerador_gradiente,
+    .passo_espacial = VOLTAS(1, 10),
+    .passo_temporal = VOLTAS(1, 10)
+};
+
+const Animacao animacao_0 = {
+    .gerador = &gerador_animacao_0,
+    .num_frames = 10,
+    .r = INTENSIDADE(1.0),
+    .g = INTENSIDADE(0.0),
+    .b = INTENSIDADE(1.0),
+    .transicao = TRANSICAO_LINEAR,
+    .periodo_us = PERIODO_FPS(7)
+};
+
+// Fade senoidal em tabuleiro, um ciclo a cada 10 quadros
+static const Gerador gerador_animacao_1 = {
+    .funcao = gerador_fade,
+    .passo_temporal = VOLTAS(1, 10)
+};
+
+const Animacao animacao_1 = {
+    .gerador = &gerador_animacao_1,
+    .num_frames = 20,
+    .r = INTENSIDADE(1.0),
+    .g = INTENSIDADE(0.8),
+    .b = INTENSIDADE(0.0),
+    .transicao = TRANSICAO_SUAVE,
+    .periodo_us = PERIODO_FPS(5)
+};
+
+static const uint8_t frames_animacao_2[][NUM_PIXELS] = {
+    {
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51
+    },
+    {
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255
+    },
+    {
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51
+    },
+    {
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255
+    },
+    {
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51
+    },
+    {
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255
+    },
+    {
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51
+    },
+    {
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255
+    },
+    {
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51
+    },
+    {
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255,
+        255, 204, 153, 102,  51,
+         51, 102, 153, 204, 255
+    }
+};
+
+const Animacao animacao_2 = {
+    .frames = frames_animacao_2,
+    .num_frames = count_of(frames_animacao_2),
+    .r = INTENSIDADE(0.0),
+    .g = INTENSIDADE(0.0),
+    .b = INTENSIDADE(1.0),
+    .periodo_us = PERIODO_FPS(5)
+};
+
+// Espiral a partir do centro, uma casa por quadro até encher a matriz
+static const Gerador gerador_animacao_3_espiral_LUIZ = {
+    .funcao = gerador_espiral,
+    .passo_temporal = 1
+};
+
+const Animacao animacao_3_espiral_LUIZ = {
+    .gerador = &gerador_animacao_3_espiral_LUIZ,
+    .num_frames = MATRIZ_LARGURA * MATRIZ_ALTURA,
+    .r = INTENSIDADE(0.0),
+    .g = INTENSIDADE(1.0),
+    .b = INTENSIDADE(0.0),
+    .periodo_us = PERIODO_FPS(3)
+};
+
+// Barra vertical indo e voltando, uma coluna por quadro
+static const Gerador gerador_animacao_4 = {
+    .funcao = gerador_barra,
+    .passo_temporal = 256
+};
+
+const Animacao animacao_4 = {
+    .gerador = &gerador_animacao_4,
+    .num_frames = 2 * (MATRIZ_LARGURA - 1) + 1,
+    .r = INTENSIDADE(0.0),
+    .g = INTENSIDADE(1.0),
+    .b = INTENSIDADE(1.0),
+    .transicao = TRANSICAO_SUAVE,
+    .periodo_us = PERIODO_FPS(3)
+};
+
+// Nome rolando, cada letra com sua cor e um tom mais agudo que o anterior
+static const EstiloTexto estilos_lorenzo[] = {
+    {255,   0,   0, 440}, // L - Vermelho
+    {  0, 255,   0, 490}, // O - Verde
+    {  0,   0, 255, 540}, // R - Azul
+    {255, 255,   0, 590}, // E - Amarelo
+    {255,   0, 255, 640}, // N - Magenta
+    {  0, 255, 255, 690}, // Z - Ciano
+    {255, 128,   0, 740}  // O - Laranja
+};
+
+const Texto texto_lorenzo = {
+    .mensagem = "LORENZO",
+    .estilos = estilos_lorenzo,
+    .num_estilos = count_of(estilos_lorenzo),
+    .colunas_por_s = 10,
+    .tom_ms = 200
+};
+
+// Notas da música, em Hz
+#define DO  261
+#define RE  293
+#define MI  329
+#define FA  349
+#define SOL 392
+
+// Uma nota por quadro, em degradê de azul: o dó é o azul mais forte e o sol
+// o mais claro
+static const PassoLinha passos_musica[] = {
+    { 0, 0, 0, 255, DO,  250, PERIODO_FPS(4)},
+    { 1, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    { 2, 0, 0, 153, MI,  250, PERIODO_FPS(4)},
+    { 3, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    { 4, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    { 5, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    { 6, 0, 0, 255, DO,  250, PERIODO_FPS(4)},
+    { 7, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    { 8, 0, 0, 255, DO,  250, PERIODO_FPS(4)},
+    { 9, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    {10, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    {11, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    {12, 0, 0, 255, DO,  250, PERIODO_FPS(4)},
+    {13, 0, 0,  51, SOL, 250, PERIODO_FPS(4)},
+    {14, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    {15, 0, 0, 153, MI,  250, PERIODO_FPS(4)},
+    {16, 0, 0, 153, MI,  250, PERIODO_FPS(4)},
+    {17, 0, 0, 153, MI,  250, PERIODO_FPS(4)},
+    {18, 0, 0, 255, DO,  250, PERIODO_FPS(4)},
+    {19, 0, 0, 204, RE,  250, PERIODO_FPS(4)},
+    {20, 0, 0, 153, MI,  250, PERIODO_FPS(4)},
+    {21, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    {22, 0, 0, 102, FA,  250, PERIODO_FPS(4)},
+    {23, 0, 0, 102, FA,  250, PERIODO_FPS(4)}
+};
+
+const LinhaTempo linha_musica = {
+    .anim = &animacao_6_musica,
+    .passos = passos_musica,
+    .num_passos = count_of(passos_musica)
+};
+
+// Sirene de polícia
+static const uint8_t frames_animacao_7_sirene[][NUM_PIXELS] = {
+    { // Vermelho
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0,
+          0, 255,   0,   0, 255,
+          0, 255,   0,   0, 255
+    },
+    { // Azul
+          0, 255,   0,   0, 255,
+          0,   0, 255,   0,   0,
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0
+    },
+    { // Vermelho
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0,
+          0, 255,   0,   0, 255,
+          0, 255,   0,   0, 255
+    },
+    { // Azul
+          0, 255,   0,   0, 255,
+          0,   0, 255,   0,   0,
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0
+    },
+    { // Vermelho
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0,
+          0, 255,   0,   0, 255,
+          0, 255,   0,   0, 255
+    },
+    { // Azul
+          0, 255,   0,   0, 255,
+          0,   0, 255,   0,   0,
+        255,   0,   0, 255,   0,
+        255,   0,   0, 255,   0,
+          0,   0, 255,   0,   0
+    }
+};
+
+const Animacao animacao_7_sirene = {
+    .frames = frames_animacao_7_sirene,
+    .num_frames = count_of(frames_animacao_7_sirene),
+    .r = INTENSIDADE(1.0),
+    .g = INTENSIDADE(0.0),
+    .b = INTENSIDADE(0.0),
+    .periodo_us = PERIODO_FPS(3)
+};
+
+static const uint8_t frames_animacao_8_countdown[][NUM_PIXELS] = {
+    { // 5
+        204, 204, 204, 204, 204,
+        204,   0,   0,   0,   0,
+        204, 204, 204, 204, 204,
+          0,   0,   0,   0, 204,
+        204, 204, 204, 204, 204
+    },
+    { // 4
+        204,   0,   0,   0, 204,
+        204,   0,   0,   0,   0,
+        204, 204, 204, 204, 204,
+          0,   0,   0,   0, 204,
+          0,   0,   0,   0, 204
+    },
+    { // 3
+        204, 204, 204, 204, 204,
+          0,   0,   0,   0, 204,
+        204, 204, 204, 204, 204,
+          0,   0,   0,   0, 204,
+        204, 204, 204, 204, 204
+    },
+    { // 2
+        204, 204, 204, 204, 204,
+          0,   0,   0,   0, 204,
+        204, 204, 204, 204, 204,
+        204,   0,   0,   0,   0,
+        204, 204, 204, 204, 204
+    },
+    { // 1
+          0,   0, 204,   0,   0,
+          0,   0, 204,   0,   0,
+          0,   0, 204,   0,   0,
+          0,   0, 204,   0,   0,
+          0,   0, 204,   0,   0
+    },
+    { // 0
+        204, 204, 204, 204, 204,
+        204,   0,   0,   0, 204,
+        204,   0,   0,   0, 204,
+        204,   0,   0,   0, 204,
+        204, 204, 204, 204, 204
+    }
+};
+
+const Animacao animacao_8_countdown = {
+    .frames = frames_animacao_8_countdown,
+    .num_frames = count_of(frames_animacao_8_countdown),
+    .r = INTENSIDADE(1.0),
+    .g = INTENSIDADE(0.0),
+    .b = INTENSIDADE(0.0),
+    .transicao = TRANSICAO_SUAVE,
+    .periodo_us = PERIODO_FPS(1)
+};
+
+// Três segundos alternando vermelho em 1000 Hz e azul em 700 Hz
+static const PassoLinha passos_sirene[] = {
+    {0, 255, 0,   0, 1000, 333, PERIODO_FPS(3)},
+    {1,   0, 0, 255,  700, 333, PERIODO_FPS(3)},
+    {2, 255, 0,   0, 1000, 333, PERIODO_FPS(3)},
+    {3,   0, 0, 255,  700, 333, PERIODO_FPS(3)},
+    {4, 255, 0,   0, 1000, 333, PERIODO_FPS(3)},
+    {5,   0, 0, 255,  700, 333, PERIODO_FPS(3)},
+    {0, 255, 0,   0, 1000, 333, PERIODO_FPS(3)},
+    {1,   0, 0, 255,  700, 333, PERIODO_FPS(3)},
+    {2, 255, 0,   0, 1000, 333, PERIODO_FPS(3)}
+};
+
+const LinhaTempo linha_sirene = {
+    .anim = &animacao_7_sirene,
+    .passos = passos_sirene,
+    .num_passos = count_of(passos_sirene)
+};
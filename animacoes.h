@@ -0,0 +1,87 @@
+#ifndef ANIMACOES_H
+#define ANIMACOES_H
+
+#include "pico/stdlib.h"
+
+#include "gerador.h"
+#include "matriz_led.h"
+#include "texto.h"
+
+// Converte uma intensidade de 0.0 a 1.0 para 8 bits em tempo de compilação
+#define INTENSIDADE(x) ((uint8_t)((x) * 255.0 + 0.5))
+
+// Duração de um quadro em µs para a taxa informada, arredondada
+#define PERIODO_FPS(fps) ((1000000u + (fps) / 2) / (fps))
+
+// Taxa dos quadros intermediários das animações com transição
+#ifndef FPS_TRANSICAO
+#define FPS_TRANSICAO 60
+#endif
+
+// Como um quadro passa para o seguinte. Com transição os quadros da animação
+// viram quadros-chave e os intermediários são misturados na hora, a
+// FPS_TRANSICAO, sem ocupar flash.
+typedef enum {
+    TRANSICAO_CORTE,    // Troca direta, na taxa da animação
+    TRANSICAO_LINEAR,   // Mistura linear entre os quadros-chave
+    TRANSICAO_SUAVE     // Mistura com aceleração e desaceleração (smoothstep)
+} Transicao;
+
+// Estrutura para armazenar dados de uma animação.
+// Os quadros são intensidades em 8 bits, de uma de três fontes (as outras
+// ficam NULL): uma tabela const completa na flash (frames), um fluxo
+// comprimido decodificado um quadro por vez (fluxo.h) ou uma função
+// calculada na hora (gerador.h).
+typedef struct {
+    const uint8_t (*frames)[NUM_PIXELS];
+    const uint8_t *fluxo;
+    uint32_t tamanho_fluxo;
+    const Gerador *gerador;
+    const uint32_t *duracoes_us; // Duração de cada quadro em µs, ou NULL para usar periodo_us
+    int num_frames;
+    uint8_t r, g, b;
+    Transicao transicao;
+    uint32_t periodo_us;
+} Animacao;
+
+// Duração do quadro informado, em µs
+static inline uint32_t duracao_quadro(const Animacao *anim, int frame) {
+    return anim->duracoes_us ? anim->duracoes_us[frame] : anim->periodo_us;
+}
+
+// Um passo de uma linha do tempo: o quadro da animação, a cor dele, o tom
+// que toca junto e o tempo até o próximo passo
+typedef struct {
+    uint8_t frame;
+    uint8_t r, g, b;
+    uint16_t freq;       // Hz; 0 = sem som neste passo
+    uint16_t tom_ms;     // Duração do tom
+    uint32_t duracao_us;
+} PassoLinha;
+
+// Sequência de passos sobre os quadros de uma animação. Efeitos com cor e som
+// diferentes a cada quadro são só uma tabela destas, tocada por executar_linha.
+typedef struct {
+    const Animacao *anim;
+    const PassoLinha *passos;
+    int num_passos;
+} LinhaTempo;
+
+extern const Animacao animacao_0;
+extern const Animacao animacao_1;
+extern const Animacao animacao_2;
+extern const Animacao animacao_3_espiral_LUIZ;
+extern const Animacao animacao_4;
+extern const Animacao animacao_6_musica;
+extern const Animacao animacao_7_sirene;
+extern const Animacao animacao_8_countdown;
+extern const Animacao animacao_9_Felipe;
+
+// Cores por quadro (R, G, B) das animações com cor dinâmica
+extern const LinhaTempo linha_musica;
+extern const LinhaTempo linha_sirene;
+
+// Mensagens com a fonte de texto.h
+extern const Texto texto_lorenzo;
+
+#endif
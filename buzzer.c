@@ -0,0 +1,134 @@
+#include "buzzer.h"
+#include "telemetria.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+
+// Intervalo entre atualizações de frequência durante o glide
+#define GLIDE_PASSO_MS 5
+
+static uint buzzer_pin;
+static uint slice;
+static uint canal;
+static alarm_pool_t *pool_buzzer;
+
+static volatile alarm_id_t alarme_fim = 0;
+static repeating_timer_t timer_glide;
+static volatile bool glide_ativo = false;
+static int32_t glide_freq, glide_passo;
+static uint glide_freq_final;
+static uint32_t glide_passos;
+
+// Frequências em Hz de ponto fixo Q16 durante o glide
+#define GLIDE_Q 16
+
+// Ajusta divisor e wrap do PWM para a frequência pedida, com ciclo de 50%.
+// O divisor (8.4 bits) é o menor que mantém o wrap em 16 bits, o que dá
+// a maior resolução possível de contagem e erro de frequência desprezível.
+static void configurar_frequencia(uint frequency) {
+    uint64_t clk16 = (uint64_t)clock_get_hz(clk_sys) * 16;
+    uint32_t div16 = (clk16 + (uint64_t)frequency * 65536 - 1) / ((uint64_t)frequency * 65536);
+    if (div16 < 16) {
+        div16 = 16;
+    } else if (div16 > 0xFFF) {
+        div16 = 0xFFF;
+    }
+
+    uint32_t contagem = (clk16 + (uint64_t)div16 * frequency / 2) / ((uint64_t)div16 * frequency);
+    if (contagem > 65536) {
+        contagem = 65536;
+    }
+
+    pwm_set_clkdiv_int_frac(slice, div16 >> 4, div16 & 0xF);
+    pwm_set_wrap(slice, contagem - 1);
+    pwm_set_chan_level(slice, canal, contagem / 2);
+}
+
+static void cancelar_agendamentos(void) {
+    if (alarme_fim > 0) {
+        alarm_pool_cancel_alarm(pool_buzzer, alarme_fim);
+        alarme_fim = 0;
+    }
+    if (glide_ativo) {
+        cancel_repeating_timer(&timer_glide);
+        glide_ativo = false;
+    }
+}
+
+static int64_t alarme_parar(alarm_id_t id, void *user_data) {
+    alarme_fim = 0;
+    buzzer_parar();
+    return 0;
+}
+
+static bool passo_glide(repeating_timer_t *rt) {
+    if (--glide_passos == 0) {
+        configurar_frequencia(glide_freq_final);
+        glide_ativo = false;
+        return false;
+    }
+    glide_freq += glide_passo;
+    configurar_frequencia(glide_freq >> GLIDE_Q);
+    return true;
+}
+
+void buzzer_init(uint pin, alarm_pool_t *pool) {
+    buzzer_pin = pin;
+    pool_buzzer = pool;
+
+    gpio_set_function(buzzer_pin, GPIO_FUNC_PWM);
+    slice = pwm_gpio_to_slice_num(buzzer_pin);
+    canal = pwm_gpio_to_channel(buzzer_pin);
+
+    // O slice fica sempre ligado; silêncio é nível zero no canal
+    pwm_set_chan_level(slice, canal, 0);
+    pwm_set_enabled(slice, true);
+}
+
+void buzzer_iniciar(uint frequency) {
+    cancelar_agendamentos();
+    if (frequency == 0) {
+        buzzer_parar();
+        return;
+    }
+    configurar_frequencia(frequency);
+}
+
+void buzzer_tone(uint frequency, uint duration_ms) {
+    if (frequency == 0 || duration_ms == 0) {
+        buzzer_parar();
+        return;
+    }
+    uint32_t inicio_us = time_us_32();
+    buzzer_iniciar(frequency);
+
+    alarm_id_t id = alarm_pool_add_alarm_in_ms(pool_buzzer, duration_ms, alarme_parar, NULL, true);
+    if (id > 0) {
+        alarme_fim = id;
+    }
+    telemetria_buzzer(inicio_us);
+}
+
+void buzzer_glide(uint freq_inicial, uint freq_final, uint duration_ms) {
+    if (freq_inicial == 0 || freq_final == 0) {
+        buzzer_parar();
+        return;
+    }
+    buzzer_iniciar(freq_inicial);
+
+    glide_passos = duration_ms / GLIDE_PASSO_MS;
+    if (glide_passos == 0) {
+        configurar_frequencia(freq_final);
+        return;
+    }
+    glide_freq = (int32_t)freq_inicial << GLIDE_Q;
+    // Descendo a diferença é negativa: multiplica em vez de deslocar, que
+    // não é definido para negativos
+    glide_passo = ((int32_t)freq_final - (int32_t)freq_inicial) * (1 << GLIDE_Q) / (int32_t)glide_passos;
+    glide_freq_final = freq_final;
+    glide_ativo = alarm_pool_add_repeating_timer_ms(pool_buzzer, -GLIDE_PASSO_MS, passo_glide, NULL, &timer_glide);
+}
+
+void buzzer_parar(void) {
+    cancelar_agendamentos();
+    pwm_set_chan_level(slice, canal, 0);
+}
@@ -0,0 +1,24 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include "pico/stdlib.h"
+
+// Configura o pino do buzzer como saída PWM. O alarm pool é usado para
+// encerrar tons com duração e para os passos do glide.
+void buzzer_init(uint pin, alarm_pool_t *pool);
+
+// Toca a frequência continuamente, até buzzer_parar() ou outro tom
+void buzzer_iniciar(uint frequency);
+
+// Toca um tom em segundo plano e para sozinho após duration_ms;
+// substitui o tom anterior, se houver
+void buzzer_tone(uint frequency, uint duration_ms);
+
+// Desliza a frequência de freq_inicial a freq_final ao longo de duration_ms
+// e continua tocando freq_final até buzzer_parar() ou outro tom
+void buzzer_glide(uint freq_inicial, uint freq_final, uint duration_ms);
+
+// Interrompe o tom atual e deixa o pino em nível baixo
+void buzzer_parar(void);
+
+#endif
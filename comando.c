@@ -0,0 +1,128 @@
+#include "comando.h"
+#include "agendador.h"
+#include "buzzer.h"
+#include "compositor.h"
+#include "cor.h"
+#include "framebuffer.h"
+#include "matriz_led.h"
+#include "protocolo.h"
+#include "reprodutor.h"
+#include "telemetria.h"
+#include "hardware/irq.h"
+
+// Pool dos alarmes do render: passos do agendador, buzzer e quadros ao vivo
+static alarm_pool_t *pool_render;
+
+#if MATRIZ_DUAL_CORE
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+#include "fila.h"
+
+// Comandos do core0 para o core1
+FILA_DEFINIR(fila_comandos, 16);
+
+// Laço do core1: os alarmes do pool criado aqui disparam neste núcleo, então
+// os quadros e o buzzer nunca esperam por printf na USB ou pelo teclado
+static void nucleo1_main(void) {
+    alarm_pool_t *pool = alarm_pool_create_with_unused_hardware_alarm(16);
+    pool_render = pool;
+    cor_definir_brilho(BRILHO_INICIAL);
+    compositor_init();
+    framebuffer_iniciar_irq();
+    buzzer_init(BUZZER_PIN, pool);
+    agendador_init(pool);
+    protocolo_init(pool);
+
+    // Com SEVONPEND uma interrupção que fica pendente também acorda o __wfe,
+    // mesmo com as interrupções mascaradas
+    scb_hw->scr |= M0PLUS_SCR_SEVONPEND_BITS;
+
+    while (true) {
+        uint32_t cmd;
+        while (fila_remover(&fila_comandos, &cmd)) {
+            comando_executar(cmd);
+        }
+        // Acorda com __sev() do core0 ou com os alarmes. Como no core0, as
+        // interrupções ficam mascaradas até a medição terminar, para o tempo
+        // dos alarmes não contar como ocioso
+        uint32_t estado = save_and_disable_interrupts();
+        if (fila_vazia(&fila_comandos)) {
+            uint32_t inicio_us = time_us_32();
+            __wfe();
+            telemetria_ocioso(inicio_us);
+        }
+        restore_interrupts(estado);
+    }
+}
+#endif
+
+void comando_init(void) {
+#if MATRIZ_DUAL_CORE
+    multicore_launch_core1(nucleo1_main);
+#else
+    pool_render = alarm_pool_get_default();
+    cor_definir_brilho(BRILHO_INICIAL);
+    compositor_init();
+    framebuffer_iniciar_irq();
+    buzzer_init(BUZZER_PIN, alarm_pool_get_default());
+    agendador_init(alarm_pool_get_default());
+    protocolo_init(alarm_pool_get_default());
+#endif
+}
+
+void comando_enviar(uint32_t cmd) {
+#if MATRIZ_DUAL_CORE
+    // A fila só enche se o core1 travar; nesse caso espera por espaço
+    while (!fila_inserir(&fila_comandos, cmd)) {
+        tight_loop_contents();
+    }
+    __sev();
+#else
+    comando_executar(cmd);
+#endif
+}
+
+void comando_executar(uint32_t cmd) {
+    // Os alarmes do pool também transmitem quadros, e o framebuffer não é
+    // reentrante. Com a interrupção deles mascarada, nada do que roda aqui é
+    // interrompido no meio de uma transmissão; o alarme que vencer nesse
+    // intervalo fica pendente e roda logo depois.
+    uint irq_alarmes = TIMER_IRQ_0 + alarm_pool_hardware_alarm_num(pool_render);
+    irq_set_enabled(irq_alarmes, false);
+
+    uint32_t arg = COMANDO_ARG(cmd);
+    switch (COMANDO_TIPO(cmd)) {
+        case CMD_PARAR:
+            protocolo_cancelar_quadros();
+            agendador_parar();
+            break;
+        case CMD_EFEITO:
+            protocolo_cancelar_quadros();
+            iniciar_efeito((Efeito)arg);
+            break;
+        case CMD_PREENCHER:
+            protocolo_cancelar_quadros();
+            agendador_parar();
+            desenho_pio(arg & 0xFF, (arg >> 8) & 0xFF, arg >> 16);
+            break;
+        case CMD_QUADRO:
+            protocolo_executar_quadro(arg);
+            break;
+        case CMD_BRILHO:
+            // Vale a partir do próximo quadro desenhado
+            cor_definir_brilho(arg & 0xFF);
+            break;
+        case CMD_SOBREPOR:
+            sobrepor_efeito((Efeito)arg);
+            break;
+        case CMD_TEXTO:
+            protocolo_cancelar_quadros();
+            protocolo_executar_texto();
+            break;
+        default:
+            break;
+    }
+
+    irq_set_enabled(irq_alarmes, true);
+}
@@ -0,0 +1,34 @@
+#ifndef COMANDO_H
+#define COMANDO_H
+
+#include "pico/stdlib.h"
+
+// Comandos do núcleo de controle (core0) para o núcleo de render (core1).
+// Cada comando cabe em 32 bits: tipo nos 8 bits altos, argumento nos 24 baixos.
+typedef enum {
+    CMD_PARAR,      // Interrompe a animação e o som
+    CMD_EFEITO,     // Argumento: Efeito (reprodutor.h)
+    CMD_PREENCHER,  // Argumento: cor GRB de 24 bits
+    CMD_QUADRO,     // Argumento: buffer do quadro recebido pela USB (protocolo.h)
+    CMD_BRILHO,     // Argumento: brilho global de 0 a 255 (cor.h)
+    CMD_SOBREPOR,   // Argumento: Efeito a somar por cima do fundo (compositor.h)
+    CMD_TEXTO       // Sem argumento: mensagem recebida pela USB (protocolo.h)
+} TipoComando;
+
+#define COMANDO(tipo, arg) (((uint32_t)(tipo) << 24) | ((uint32_t)(arg) & 0xFFFFFF))
+#define COMANDO_TIPO(cmd) ((TipoComando)((cmd) >> 24))
+#define COMANDO_ARG(cmd) ((cmd) & 0xFFFFFF)
+
+// Prepara o render. Com MATRIZ_DUAL_CORE, inicia o core1, que passa a ser
+// dono do agendador, da saída para a matriz, do buzzer e da apresentação
+// dos quadros recebidos pela USB; sem ele, tudo roda no core0 com o alarm
+// pool padrão.
+void comando_init(void);
+
+// Envia um comando ao render sem esperar sua execução
+void comando_enviar(uint32_t cmd);
+
+// Executa um comando no núcleo de render
+void comando_executar(uint32_t cmd);
+
+#endif
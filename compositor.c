@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "compositor.h"
+#include "framebuffer.h"
+#include "layout.h"
+
+// Dois canais de 8 bits por palavra, um em cada metade de 16 bits. A palavra
+// GRB (G << 24 | R << 16 | B << 8) vira duas: G e B deslocados 8 bits para
+// baixo, e R com o byte 0, que fica sempre zero. Cada metade tem 8 bits de
+// folga, então produtos de 8 x 9 bits e somas de dois canais não invadem a
+// vizinha.
+#define PISTAS 0x00FF00FFu
+
+static inline uint32_t pistas_gb(uint32_t p) {
+    return (p >> 8) & PISTAS;
+}
+
+static inline uint32_t pistas_r(uint32_t p) {
+    return p & PISTAS;
+}
+
+static inline uint32_t juntar_pistas(uint32_t gb, uint32_t r) {
+    return (gb << 8) | r;
+}
+
+// Opacidade de 0 a 255 em peso de 0 a 256, para dividir por 256 com shift
+static inline uint32_t peso(uint8_t alfa) {
+    return alfa + (alfa >> 7);
+}
+
+// a * (256 - w) + b * w, por pista
+static inline uint32_t interpolar_pistas(uint32_t a, uint32_t b, uint32_t w) {
+    return ((a * (256 - w) + b * w) >> 8) & PISTAS;
+}
+
+// Soma com saturação em 8 bits: o bit 8 de cada pista indica o estouro e
+// vira uma máscara de 0xFF na mesma pista
+static inline uint32_t somar_pistas(uint32_t a, uint32_t b) {
+    uint32_t s = a + b;
+    uint32_t estouro = s & 0x01000100u;
+    return (s | (estouro - (estouro >> 8))) & PISTAS;
+}
+
+void misturar_normal(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa) {
+    uint32_t w = peso(alfa);
+    for (int i = 0; i < n; i++) {
+        uint32_t a = destino[i], b = camada[i];
+        destino[i] = juntar_pistas(interpolar_pistas(pistas_gb(a), pistas_gb(b), w),
+                                   interpolar_pistas(pistas_r(a), pistas_r(b), w));
+    }
+}
+
+void misturar_soma(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa) {
+    uint32_t w = peso(alfa);
+    for (int i = 0; i < n; i++) {
+        uint32_t a = destino[i], b = camada[i];
+        uint32_t gb = ((pistas_gb(b) * w) >> 8) & PISTAS;
+        uint32_t r = ((pistas_r(b) * w) >> 8) & PISTAS;
+        destino[i] = juntar_pistas(somar_pistas(pistas_gb(a), gb), somar_pistas(pistas_r(a), r));
+    }
+}
+
+void misturar_mascara(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa) {
+    uint32_t w = peso(alfa);
+    for (int i = 0; i < n; i++) {
+        // Com opacidade menor, a máscara escurece menos: o fator vai de 256
+        // (sem efeito) até a intensidade da máscara
+        uint32_t k = peso(camada[i] >> 24);
+        k = 256 - (((256 - k) * w) >> 8);
+        uint32_t a = destino[i];
+        destino[i] = juntar_pistas(((pistas_gb(a) * k) >> 8) & PISTAS, ((pistas_r(a) * k) >> 8) & PISTAS);
+    }
+}
+
+typedef struct {
+    uint32_t pixels[NUM_PIXELS];
+    ModoMistura modo;
+    uint8_t alfa;
+    bool visivel;
+} EstadoCamada;
+
+static EstadoCamada camadas[NUM_CAMADAS] = {
+    [CAMADA_FUNDO]        = { .modo = MISTURA_NORMAL, .alfa = 255, .visivel = true },
+    [CAMADA_MASCARA]      = { .modo = MISTURA_MASCARA, .alfa = 255 },
+    [CAMADA_SOBREPOSICAO] = { .modo = MISTURA_SOMA, .alfa = 255 }
+};
+
+// Índice na cadeia de LEDs de cada pixel da imagem, e a imagem composta
+// quando há mais de uma camada visível
+static uint16_t mapa[NUM_PIXELS];
+static uint32_t composto[NUM_PIXELS];
+
+void compositor_init(void) {
+    layout_mapa(&layout_matriz, mapa);
+}
+
+uint32_t *compositor_camada(Camada camada) {
+    return camadas[camada].pixels;
+}
+
+void compositor_configurar(Camada camada, ModoMistura modo, uint8_t alfa) {
+    camadas[camada].modo = modo;
+    camadas[camada].alfa = alfa;
+}
+
+void compositor_mostrar(Camada camada, bool visivel) {
+    camadas[camada].visivel = visivel;
+}
+
+void compositor_apresentar(void) {
+    // Uma camada opaca na base não é copiada: sozinha, ela vai direto para a
+    // saída; com outras por cima, é copiada antes da primeira mistura
+    const uint32_t *origem = NULL;
+    for (int c = 0; c < NUM_CAMADAS; c++) {
+        const EstadoCamada *camada = &camadas[c];
+        if (!camada->visivel) {
+            continue;
+        }
+        if (!origem && camada->modo == MISTURA_NORMAL && camada->alfa == 255) {
+            origem = camada->pixels;
+            continue;
+        }
+        if (!origem) {
+            memset(composto, 0, sizeof(composto));
+        } else if (origem != composto) {
+            memcpy(composto, origem, sizeof(composto));
+        }
+        origem = composto;
+        switch (camada->modo) {
+            case MISTURA_NORMAL:
+                misturar_normal(composto, camada->pixels, NUM_PIXELS, camada->alfa);
+                break;
+            case MISTURA_SOMA:
+                misturar_soma(composto, camada->pixels, NUM_PIXELS, camada->alfa);
+                break;
+            case MISTURA_MASCARA:
+                misturar_mascara(composto, camada->pixels, NUM_PIXELS, camada->alfa);
+                break;
+        }
+    }
+
+    // A única passagem pela ordem física dos LEDs
+    uint32_t *quadro = framebuffer_escrita();
+    if (!origem) {
+        memset(quadro, 0, NUM_PIXELS * sizeof(uint32_t));
+    } else {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            quadro[mapa[i]] = origem[i];
+        }
+    }
+    framebuffer_apresentar();
+}
@@ -0,0 +1,51 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "pico/stdlib.h"
+
+#include "matriz_led.h"
+
+// Composição do quadro em camadas, de baixo para cima. Cada camada tem um
+// buffer de NUM_PIXELS palavras GRB, um modo de mistura e uma opacidade, e
+// é desenhada por uma tarefa própria do agendador; o quadro apresentado é a
+// mistura das camadas visíveis. As camadas ficam na ordem da imagem, linha
+// a linha (tela.h), e só a saída segue a ordem da cadeia de LEDs (layout.h).
+typedef enum {
+    CAMADA_FUNDO,           // Efeito principal (teclas 0 a 9)
+    CAMADA_MASCARA,         // Máscara de brilho sobre o fundo
+    CAMADA_SOBREPOSICAO,    // Efeito por cima de tudo, como a sirene
+    NUM_CAMADAS
+} Camada;
+
+typedef enum {
+    MISTURA_NORMAL,     // Cobre o que está abaixo, com a opacidade da camada
+    MISTURA_SOMA,       // Soma os canais com saturação: o preto é transparente
+    MISTURA_MASCARA     // Multiplica o que está abaixo pela intensidade do canal G (camada cinza)
+} ModoMistura;
+
+// Monta a tabela da ordem dos LEDs a partir de layout_matriz. Deve ser
+// chamada no núcleo de render antes do primeiro quadro.
+void compositor_init(void);
+
+// Buffer da camada, onde a tarefa dela desenha
+uint32_t *compositor_camada(Camada camada);
+
+// Modo de mistura e opacidade (0 a 255) da camada
+void compositor_configurar(Camada camada, ModoMistura modo, uint8_t alfa);
+
+// Mostra ou esconde a camada na composição
+void compositor_mostrar(Camada camada, bool visivel);
+
+// Mistura as camadas visíveis, leva o resultado para o back buffer na ordem
+// dos LEDs e o apresenta
+void compositor_apresentar(void);
+
+// Núcleos de mistura: aplicam n pixels da camada sobre o destino, no lugar.
+// Trabalham na palavra GRB inteira, com dois canais de 8 bits em cada metade
+// de 16 bits (SWAR), então cada pixel custa duas multiplicações por operando
+// em vez de uma por canal.
+void misturar_normal(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa);
+void misturar_soma(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa);
+void misturar_mascara(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa);
+
+#endif
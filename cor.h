@@ -0,0 +1,36 @@
+#ifndef COR_H
+#define COR_H
+
+#include "pico/stdlib.h"
+
+// Correção de cor na saída: cada canal de 8 bits passa por uma tabela de 256
+// entradas que junta a curva gama dos LEDs e o brilho global. A tabela só é
+// recalculada quando o brilho muda, então o custo por pixel é de três
+// leituras e alguns deslocamentos.
+//
+// Os quadros recebidos prontos pela USB (protocolo.h) não passam por aqui.
+
+// Brilho global inicial (0 a 255), usado até o primeiro CMD_BRILHO
+#ifndef BRILHO_INICIAL
+#define BRILHO_INICIAL 255
+#endif
+
+extern uint8_t tabela_cor[256];
+
+// Recalcula a tabela para o brilho informado (255 = sem limite). Deve ser
+// chamada no núcleo de render, que é quem lê a tabela.
+void cor_definir_brilho(uint8_t brilho);
+
+// Brilho global atual
+uint8_t cor_brilho(void);
+
+// Intensidade de 8 bits só com a curva gama, sem o brilho: multiplicada por
+// uma cor de cor_grb(), dá a cor com a intensidade aplicada antes da correção
+uint8_t cor_gama(uint8_t v);
+
+// Cor RGB linear de 8 bits corrigida e empacotada em GRB
+static inline uint32_t cor_grb(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)tabela_cor[g] << 24) | ((uint32_t)tabela_cor[r] << 16) | ((uint32_t)tabela_cor[b] << 8);
+}
+
+#endif
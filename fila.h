@@ -0,0 +1,52 @@
+#ifndef FILA_H
+#define FILA_H
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Fila circular sem trava para um produtor e um consumidor (por exemplo,
+// uma interrupção e o laço principal, ou os dois núcleos). Os índices
+// crescem livremente e só o produtor escreve em fim, só o consumidor em
+// inicio. A capacidade precisa ser potência de 2.
+typedef struct {
+    uint32_t *dados;
+    uint32_t mascara;
+    volatile uint32_t inicio;
+    volatile uint32_t fim;
+} Fila;
+
+// Declara uma fila estática com a capacidade informada
+#define FILA_DEFINIR(nome, capacidade) \
+    static uint32_t nome##_dados[capacidade]; \
+    static Fila nome = { nome##_dados, (capacidade) - 1, 0, 0 }
+
+// Insere um valor; retorna false se a fila estiver cheia
+static inline bool fila_inserir(Fila *f, uint32_t valor) {
+    uint32_t fim = f->fim;
+    if (fim - f->inicio > f->mascara) {
+        return false;
+    }
+    f->dados[fim & f->mascara] = valor;
+    __dmb(); // O dado precisa estar visível antes do novo índice
+    f->fim = fim + 1;
+    return true;
+}
+
+// Remove o valor mais antigo; retorna false se a fila estiver vazia
+static inline bool fila_remover(Fila *f, uint32_t *valor) {
+    uint32_t inicio = f->inicio;
+    if (inicio == f->fim) {
+        return false;
+    }
+    __dmb();
+    *valor = f->dados[inicio & f->mascara];
+    __dmb(); // A leitura termina antes de liberar a posição ao produtor
+    f->inicio = inicio + 1;
+    return true;
+}
+
+static inline bool fila_vazia(const Fila *f) {
+    return f->inicio == f->fim;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include <string.h>
+
+#include "fluxo.h"
+
+bool fluxo_iniciar(Fluxo *f, const uint8_t *dados, size_t tamanho) {
+    if (tamanho < FLUXO_CABECALHO) {
+        return false;
+    }
+    f->inicio = dados;
+    f->fim = dados + tamanho;
+    f->pos = dados + FLUXO_CABECALHO;
+    f->num_pixels = dados[0] | (dados[1] << 8);
+    f->num_frames = dados[2] | (dados[3] << 8);
+    f->frame = -1;
+    return true;
+}
+
+// Decodifica um pacote RLE em quadro[*pixel...]; false se passar do fim
+static bool ler_pacote(Fluxo *f, uint8_t *quadro, uint *pixel) {
+    if (f->pos >= f->fim) {
+        return false;
+    }
+    uint c = *f->pos++;
+    if (c < 128) {
+        uint n = c + 1;
+        if (*pixel + n > f->num_pixels || f->fim - f->pos < n) {
+            return false;
+        }
+        memcpy(&quadro[*pixel], f->pos, n);
+        f->pos += n;
+        *pixel += n;
+    } else {
+        uint n = c - 125;
+        if (*pixel + n > f->num_pixels || f->pos >= f->fim) {
+            return false;
+        }
+        memset(&quadro[*pixel], *f->pos++, n);
+        *pixel += n;
+    }
+    return true;
+}
+
+// Salto de um delta: soma de bytes 255 terminada por um byte menor
+static bool ler_salto(Fluxo *f, uint *salto) {
+    *salto = 0;
+    while (f->pos < f->fim) {
+        uint b = *f->pos++;
+        *salto += b;
+        if (b < 255) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool fluxo_proximo(Fluxo *f, uint8_t *quadro) {
+    if (f->frame + 1 >= f->num_frames || f->pos >= f->fim) {
+        return false;
+    }
+
+    uint pixel = 0;
+    switch (*f->pos++) {
+        case FLUXO_CHAVE:
+            while (pixel < f->num_pixels) {
+                if (!ler_pacote(f, quadro, &pixel)) {
+                    return false;
+                }
+            }
+            break;
+        case FLUXO_DELTA:
+            while (true) {
+                uint salto;
+                if (!ler_salto(f, &salto)) {
+                    return false;
+                }
+                pixel += salto;
+                if (pixel >= f->num_pixels) {
+                    break;
+                }
+                if (!ler_pacote(f, quadro, &pixel)) {
+                    return false;
+                }
+                if (pixel == f->num_pixels) {
+                    break;
+                }
+            }
+            if (pixel != f->num_pixels) {
+                return false;
+            }
+            break;
+        case FLUXO_REPETE:
+            break;
+        default:
+            return false;
+    }
+    f->frame++;
+    return true;
+}
+
+bool fluxo_ir_para(Fluxo *f, int frame, uint8_t *quadro) {
+    if (frame < f->frame) {
+        f->pos = f->inicio + FLUXO_CABECALHO;
+        f->frame = -1;
+    }
+    while (f->frame < frame) {
+        if (!fluxo_proximo(f, quadro)) {
+            return false;
+        }
+    }
+    return true;
+}
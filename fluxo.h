@@ -0,0 +1,49 @@
+#ifndef FLUXO_H
+#define FLUXO_H
+
+#include "pico/stdlib.h"
+
+// Formato comprimido de animação, lido direto da flash um quadro por vez.
+//
+// Cabeçalho: número de pixels e número de quadros (16 bits cada, little-endian).
+// Cada quadro começa com um byte de tipo:
+//   FLUXO_CHAVE   todos os pixels, em pacotes RLE
+//   FLUXO_DELTA   só os pixels que mudaram: pares (salto, pacote RLE) até o
+//                 fim do quadro; o salto usa bytes 255 como continuação
+//   FLUXO_REPETE  quadro igual ao anterior
+// Pacote RLE: byte c < 128 seguido de c + 1 valores literais, ou c >= 128
+// seguido de um valor repetido c - 125 vezes (3 a 130).
+//
+// O codificador fica em host/codificador_fluxo.c.
+
+#define FLUXO_CABECALHO 4
+
+enum {
+    FLUXO_CHAVE = 0,
+    FLUXO_DELTA = 1,
+    FLUXO_REPETE = 2
+};
+
+// Estado do decodificador: só a posição na flash. O quadro decodificado
+// fica em um buffer de num_pixels bytes do chamador, que precisa ser mantido
+// entre as chamadas porque os deltas partem do quadro anterior.
+typedef struct {
+    const uint8_t *inicio;
+    const uint8_t *fim;
+    const uint8_t *pos;
+    uint16_t num_pixels;
+    uint16_t num_frames;
+    int frame; // Índice do último quadro decodificado, -1 antes do primeiro
+} Fluxo;
+
+// Lê o cabeçalho; retorna false se os dados forem curtos demais
+bool fluxo_iniciar(Fluxo *f, const uint8_t *dados, size_t tamanho);
+
+// Decodifica o próximo quadro sobre o anterior em quadro[]. Retorna false no
+// fim do fluxo ou se os dados estiverem corrompidos.
+bool fluxo_proximo(Fluxo *f, uint8_t *quadro);
+
+// Decodifica até o quadro informado, recomeçando do início se ele já passou
+bool fluxo_ir_para(Fluxo *f, int frame, uint8_t *quadro);
+
+#endif
@@ -0,0 +1,27 @@
+// Gerado por host/codificador_fluxo a partir de fluxos/animacao_6_musica.txt; não editar.
+// 24 quadros de 25 pixels: 112 bytes (600 sem compressão)
+
+#include "animacoes.h"
+
+static const uint8_t fluxo_animacao_6_musica[] = {
+    0x19, 0x00, 0x18, 0x00, 0x00, 0x82, 0xff, 0x91, 0x00, 0x00, 0x82, 0x00,
+    0x82, 0xff, 0x8c, 0x00, 0x00, 0x87, 0x00, 0x82, 0xff, 0x87, 0x00, 0x00,
+    0x8c, 0x00, 0x82, 0xff, 0x82, 0x00, 0x02, 0x02, 0x00, 0x82, 0xff, 0x91,
+    0x00, 0x00, 0x82, 0x00, 0x82, 0xff, 0x8c, 0x00, 0x00, 0x82, 0xff, 0x91,
+    0x00, 0x00, 0x82, 0x00, 0x82, 0xff, 0x8c, 0x00, 0x02, 0x02, 0x00, 0x82,
+    0xff, 0x91, 0x00, 0x00, 0x91, 0x00, 0x82, 0xff, 0x00, 0x8c, 0x00, 0x82,
+    0xff, 0x82, 0x00, 0x00, 0x87, 0x00, 0x82, 0xff, 0x87, 0x00, 0x02, 0x02,
+    0x00, 0x82, 0xff, 0x91, 0x00, 0x00, 0x82, 0x00, 0x82, 0xff, 0x8c, 0x00,
+    0x00, 0x87, 0x00, 0x82, 0xff, 0x87, 0x00, 0x00, 0x8c, 0x00, 0x82, 0xff,
+    0x82, 0x00, 0x02, 0x02,
+};
+
+const Animacao animacao_6_musica = {
+    .fluxo = fluxo_animacao_6_musica,
+    .tamanho_fluxo = sizeof(fluxo_animacao_6_musica),
+    .num_frames = 24,
+    .r = 0,
+    .g = 0,
+    .b = 0,
+    .periodo_us = PERIODO_FPS(4)
+};
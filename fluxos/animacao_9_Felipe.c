@@ -0,0 +1,28 @@
+// Gerado por host/codificador_fluxo a partir de fluxos/animacao_9_Felipe.txt; não editar.
+// 10 quadros de 25 pixels: 130 bytes (250 sem compressão)
+
+#include "animacoes.h"
+
+static const uint8_t fluxo_animacao_9_Felipe[] = {
+    0x19, 0x00, 0x0a, 0x00, 0x00, 0x02, 0x00, 0x00, 0xff, 0x93, 0x00, 0x00,
+    0x84, 0x00, 0x00, 0xff, 0x8e, 0x00, 0x00, 0x89, 0x00, 0x00, 0xff, 0x89,
+    0x00, 0x02, 0x01, 0x07, 0x00, 0xff, 0x03, 0x02, 0xff, 0x00, 0xff, 0x03,
+    0x00, 0xff, 0x07, 0x00, 0x83, 0x00, 0x02, 0xff, 0x00, 0xff, 0x80, 0x00,
+    0x00, 0xff, 0x80, 0x00, 0x02, 0xff, 0x00, 0xff, 0x83, 0x00, 0x00, 0x84,
+    0x00, 0x00, 0xff, 0x80, 0x00, 0x02, 0xff, 0x00, 0xff, 0x80, 0x00, 0x00,
+    0xff, 0x84, 0x00, 0x00, 0x83, 0x00, 0x02, 0xff, 0x00, 0xff, 0x80, 0x00,
+    0x00, 0xff, 0x80, 0x00, 0x02, 0xff, 0x00, 0xff, 0x83, 0x00, 0x00, 0x84,
+    0x00, 0x00, 0xff, 0x80, 0x00, 0x02, 0xff, 0x00, 0xff, 0x80, 0x00, 0x00,
+    0xff, 0x84, 0x00, 0x00, 0x83, 0x00, 0x02, 0xff, 0x00, 0xff, 0x80, 0x00,
+    0x00, 0xff, 0x80, 0x00, 0x02, 0xff, 0x00, 0xff, 0x83, 0x00,
+};
+
+const Animacao animacao_9_Felipe = {
+    .fluxo = fluxo_animacao_9_Felipe,
+    .tamanho_fluxo = sizeof(fluxo_animacao_9_Felipe),
+    .num_frames = 10,
+    .r = 0,
+    .g = 255,
+    .b = 255,
+    .periodo_us = PERIODO_FPS(5)
+};
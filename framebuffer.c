@@ -0,0 +1,150 @@
+#include <string.h>
+
+#include "framebuffer.h"
+#include "telemetria.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Dois buffers: um é transmitido pelo DMA enquanto o outro é desenhado
+static uint32_t buffers[2][NUM_PIXELS];
+static uint indice_escrita = 0;
+
+// Um canal por faixa, disparados juntos pela máscara
+static int canais_dma[NUM_FAIXAS];
+static uint32_t mascara_canais = 0;
+
+// State machines das faixas e as que ainda não travaram o último quadro
+// (bit k: faixa k). Zera na interrupção de fim de quadro.
+static PIO pio_saida;
+static uint sms_saida[NUM_FAIXAS];
+static volatile uint32_t faixas_pendentes = 0;
+
+// Último quadro transmitido, para não reenviar um quadro igual
+static const uint32_t *ultimo_quadro = NULL;
+static EstatisticasFramebuffer estatisticas;
+
+void framebuffer_init(PIO pio, const uint sms[NUM_FAIXAS]) {
+    pio_saida = pio;
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        sms_saida[k] = sms[k];
+
+        canais_dma[k] = dma_claim_unused_channel(true);
+
+        dma_channel_config c = dma_channel_get_default_config(canais_dma[k]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        // Só transfere quando a FIFO TX da state machine tem espaço
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sms[k], true));
+
+        dma_channel_configure(canais_dma[k], &c, &pio->txf[sms[k]],
+                              &buffers[0][k * PIXELS_POR_FAIXA], PIXELS_POR_FAIXA, false);
+        mascara_canais |= 1u << canais_dma[k];
+
+        // O programa levanta a flag de mesmo número da state machine (irq 0 rel)
+        pio_interrupt_clear(pio, sms[k]);
+        pio_set_irq1_source_enabled(pio, pis_interrupt0 + sms[k], true);
+    }
+}
+
+// Fim de quadro: cada faixa avisa quando os LEDs travaram o quadro, depois
+// do reset que o próprio programa PIO garante
+static void tratar_fim_quadro(void) {
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        if (pio_interrupt_get(pio_saida, sms_saida[k])) {
+            pio_interrupt_clear(pio_saida, sms_saida[k]);
+            faixas_pendentes &= ~(1u << k);
+        }
+    }
+    // Acorda framebuffer_aguardar(), mesmo que ela esteja no outro núcleo
+    __sev();
+}
+
+void framebuffer_iniciar_irq(void) {
+    // Prioridade máxima: os quadros são apresentados dentro dos callbacks
+    // dos alarmes, e a espera pelo anterior depende desta interrupção
+    uint irq = (pio_saida == pio0) ? PIO0_IRQ_1 : PIO1_IRQ_1;
+    irq_set_exclusive_handler(irq, tratar_fim_quadro);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    irq_set_enabled(irq, true);
+}
+
+uint32_t *framebuffer_escrita(void) {
+    return buffers[indice_escrita];
+}
+
+// Indica se o quadro é igual ao último transmitido, que continua na matriz
+static bool quadro_repetido(const uint32_t *quadro) {
+    return ultimo_quadro && memcmp(quadro, ultimo_quadro, sizeof(buffers[0])) == 0;
+}
+
+// Espera o quadro anterior travar, medindo só quando ele ainda não travou
+static void aguardar_transmissao(void) {
+    if (framebuffer_ocupado()) {
+        uint32_t inicio_us = time_us_32();
+        framebuffer_aguardar();
+        telemetria_espera_fifo(inicio_us);
+    }
+}
+
+static void transmitir(const uint32_t *quadro) {
+    aguardar_transmissao();
+
+    // O contador de transferências é recarregado a cada disparo do canal.
+    // As faixas ficam pendentes antes do disparo, que leva à interrupção.
+    faixas_pendentes = (1u << NUM_FAIXAS) - 1;
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        dma_channel_set_read_addr(canais_dma[k], &quadro[k * PIXELS_POR_FAIXA], false);
+    }
+    dma_start_channel_mask(mascara_canais);
+    ultimo_quadro = quadro;
+    estatisticas.enviados++;
+    telemetria_quadro_apresentado();
+}
+
+void framebuffer_apresentar(void) {
+    // Um quadro igual não é transmitido nem trocado: o back buffer continua o
+    // mesmo e o front buffer segue sendo o último enviado
+    if (quadro_repetido(buffers[indice_escrita])) {
+        estatisticas.repetidos++;
+        telemetria_quadro_apresentado();
+        return;
+    }
+    // O buffer que vai virar back buffer ainda pode estar sendo lido pelo DMA
+    transmitir(buffers[indice_escrita]);
+    indice_escrita ^= 1;
+}
+
+void framebuffer_apresentar_quadro(const uint32_t *quadro) {
+    // Espera mesmo sem transmitir: quem chama pode reaproveitar o buffer
+    // anterior assim que esta função retorna
+    aguardar_transmissao();
+    if (quadro_repetido(quadro)) {
+        ultimo_quadro = quadro;
+        estatisticas.repetidos++;
+        telemetria_quadro_apresentado();
+        return;
+    }
+    transmitir(quadro);
+}
+
+bool framebuffer_ocupado(void) {
+    return faixas_pendentes != 0;
+}
+
+void framebuffer_aguardar(void) {
+    // A interrupção de fim de quadro termina com __sev(), então uma que chegue
+    // entre o teste e o __wfe() não se perde
+    while (faixas_pendentes != 0) {
+        __wfe();
+    }
+}
+
+void framebuffer_estatisticas(EstatisticasFramebuffer *copia) {
+    memcpy(copia, &estatisticas, sizeof(estatisticas));
+}
+
+void framebuffer_zerar_estatisticas(void) {
+    memset(&estatisticas, 0, sizeof(estatisticas));
+}
@@ -0,0 +1,50 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+#include "matriz_led.h"
+
+// Quadros apresentados desde o último zerar. Um quadro igual ao último
+// transmitido não é enviado de novo: os LEDs mantêm a cor sozinhos.
+typedef struct {
+    uint32_t enviados;
+    uint32_t repetidos;     // Iguais ao anterior, não transmitidos
+} EstatisticasFramebuffer;
+
+// Configura um canal DMA por faixa, cada um alimentando a state machine da
+// sua faixa (sms[k]). O DMA é cadenciado pelo DREQ da FIFO TX, então a CPU
+// não espera pelo PIO. As state machines rodam o programa de matriz_led.pio,
+// que levanta a flag de IRQ de cada uma quando o quadro trava nos LEDs.
+void framebuffer_init(PIO pio, const uint sms[NUM_FAIXAS]);
+
+// Habilita a interrupção de fim de quadro no núcleo que chama, que deve ser
+// o do render (depois de framebuffer_init)
+void framebuffer_iniciar_irq(void);
+
+// Buffer onde o próximo quadro deve ser desenhado (back buffer), em GRB empacotado
+uint32_t *framebuffer_escrita(void);
+
+// Envia o back buffer para a matriz e troca os buffers sem esperar a transmissão.
+// Todas as faixas começam juntas. Só bloqueia se o quadro anterior ainda não
+// tiver travado nos LEDs (transmissão mais o reset). Se o quadro for igual ao último enviado, nada
+// é transmitido e os buffers não são trocados.
+void framebuffer_apresentar(void);
+
+// Envia um quadro de NUM_PIXELS palavras GRB direto de outro buffer, sem
+// copiá-lo para o back buffer. O buffer precisa continuar válido e sem
+// alterações até a próxima apresentação, que o compara com o novo quadro.
+void framebuffer_apresentar_quadro(const uint32_t *quadro);
+
+// Indica se ainda há um quadro sendo transmitido ou no reset, antes de travar
+bool framebuffer_ocupado(void);
+
+// Aguarda o quadro em andamento travar nos LEDs
+void framebuffer_aguardar(void);
+
+// Copia os contadores de quadros enviados e repetidos
+void framebuffer_estatisticas(EstatisticasFramebuffer *copia);
+void framebuffer_zerar_estatisticas(void);
+
+#endif
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+
+#include "gerador.h"
+
+// Um quarto de onda do seno em Q1.15, em 64 passos e mais o ponto final
+static const int16_t quarto_seno[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,  6393,
+     7179,  7962,  8739,  9512, 10278, 11039, 11793, 12539, 13279,
+    14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519,
+    20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811,
+    25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898,
+    29268, 29621, 29956, 30273, 30571, 30852, 31113, 31356, 31580,
+    31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728,
+    32757, 32767
+};
+
+int32_t seno_q15(uint32_t fase) {
+    uint32_t quadrante = (fase >> 14) & 3;
+    uint32_t resto = fase & 0x3FFF;
+    // No segundo e no quarto quadrantes a onda é espelhada
+    if (quadrante & 1) {
+        resto = 0x4000 - resto;
+    }
+
+    // Interpolação linear entre dois pontos da tabela (8 bits de fração)
+    uint32_t i = resto >> 8;
+    int32_t valor = quarto_seno[i];
+    if (i < 64) {
+        valor += ((quarto_seno[i + 1] - valor) * (int32_t)(resto & 0xFF)) >> 8;
+    }
+    return (quadrante & 2) ? -valor : valor;
+}
+
+uint8_t onda(uint32_t fase) {
+    // (1 - cos) / 2, de 0 a 65534, levado para 0 a 255
+    uint32_t x = 32767 - seno_q15(fase + 0x4000);
+    return (x * 255 + 32767) >> 16;
+}
+
+void gerador_desenhar(const Gerador *g, uint32_t frame, uint8_t *intensidades) {
+    for (int y = 0; y < MATRIZ_ALTURA; y++) {
+        for (int x = 0; x < MATRIZ_LARGURA; x++) {
+            *intensidades++ = g->funcao(g, frame, x, y);
+        }
+    }
+}
+
+uint8_t gerador_gradiente(const Gerador *g, uint32_t frame, int x, int y) {
+    return onda((x + y) * g->passo_espacial - frame * g->passo_temporal);
+}
+
+uint8_t gerador_fade(const Gerador *g, uint32_t frame, int x, int y) {
+    // O fade vai até 80% e as casas claras somam mais 20%
+    uint32_t nivel = (onda(frame * g->passo_temporal) * 205) >> 8;
+    return nivel + (((x + y) & 1) ? 51 : 0);
+}
+
+// Ordem de uma casa na espiral quadrada: o centro é 0 e cada anel n começa
+// logo abaixo do canto superior direito e segue em sentido horário
+static uint ordem_espiral(int x, int y) {
+    int dx = x - (MATRIZ_LARGURA - 1) / 2;
+    int dy = y - (MATRIZ_ALTURA - 1) / 2;
+    int n = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+    if (n == 0) {
+        return 0;
+    }
+
+    int inicio = (2 * n - 1) * (2 * n - 1);
+    if (dx == n && dy > -n) {
+        return inicio + (dy + n - 1);          // lado direito, descendo
+    } else if (dy == n) {
+        return inicio + 2 * n + (n - dx - 1);  // base, para a esquerda
+    } else if (dx == -n) {
+        return inicio + 4 * n + (n - dy - 1);  // lado esquerdo, subindo
+    }
+    return inicio + 6 * n + (dx + n - 1);      // topo, para a direita
+}
+
+uint8_t gerador_espiral(const Gerador *g, uint32_t frame, int x, int y) {
+    return ordem_espiral(x, y) <= frame * g->passo_temporal ? 255 : 0;
+}
+
+uint8_t gerador_barra(const Gerador *g, uint32_t frame, int x, int y) {
+    // Posição em Q8.8, indo e voltando entre a primeira e a última coluna
+    int32_t ida = (MATRIZ_LARGURA - 1) << 8;
+    int32_t p = (int32_t)((frame * g->passo_temporal) % (2 * ida));
+    int32_t posicao = p <= ida ? p : 2 * ida - p;
+
+    // Acesa por inteiro na coluna da posição, apagando até um pixel de distância
+    int32_t distancia = abs((x << 8) - posicao);
+    return distancia >= 256 ? 0 : 255 - distancia;
+}
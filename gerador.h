@@ -0,0 +1,49 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include "pico/stdlib.h"
+
+#include "layout.h"
+
+// Animações procedurais: em vez de uma tabela de quadros, uma função
+// (quadro, x, y) -> intensidade calculada na hora, em ponto fixo.
+// O tamanho, a resolução e a velocidade não custam memória extra.
+
+// Fração de volta em Q16 (65536 = uma volta completa)
+#define VOLTAS(num, den) ((int32_t)(((int64_t)(num) << 16) / (den)))
+
+typedef struct Gerador Gerador;
+
+// Intensidade (0 a 255) do pixel (x, y) no quadro informado
+typedef uint8_t (*funcao_gerador_t)(const Gerador *g, uint32_t frame, int x, int y);
+
+struct Gerador {
+    funcao_gerador_t funcao;
+    int32_t passo_espacial; // Variação por pixel (Q16 voltas ou Q8.8 pixels, conforme a função)
+    int32_t passo_temporal; // Variação por quadro, na mesma unidade
+};
+
+// Calcula um quadro inteiro em intensidades[], linha a linha (layout.h)
+void gerador_desenhar(const Gerador *g, uint32_t frame, uint8_t *intensidades);
+
+// Seno em Q1.15 de uma fase em voltas Q16, por tabela de um quarto de onda
+int32_t seno_q15(uint32_t fase);
+
+// Onda de 0 a 255 que começa em 0 na fase zero e chega a 255 em meia volta
+uint8_t onda(uint32_t fase);
+
+// Funções prontas para os campos de Gerador:
+
+// Onda senoidal na diagonal (x + y), correndo no tempo (Q16 voltas)
+uint8_t gerador_gradiente(const Gerador *g, uint32_t frame, int x, int y);
+
+// Fade senoidal com as casas de um tabuleiro de xadrez 20% mais fortes (Q16 voltas)
+uint8_t gerador_fade(const Gerador *g, uint32_t frame, int x, int y);
+
+// Espiral quadrada que acende a partir do centro, passo_temporal casas por quadro
+uint8_t gerador_espiral(const Gerador *g, uint32_t frame, int x, int y);
+
+// Barra vertical que vai e volta, com bordas suavizadas (posição em Q8.8 pixels)
+uint8_t gerador_barra(const Gerador *g, uint32_t frame, int x, int y);
+
+#endif
@@ -0,0 +1,474 @@
+// Benchmark do render no host: mede o custo por pixel de cada caminho de
+// desenho e grava o fluxo GRB que iria para a matriz, para comparar com uma
+// gravação de referência (golden) feita antes de uma mudança.
+//
+// Uso: bench_matriz [-n iterações] [-o pasta_saida] [-g pasta_golden]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "hal_fake.h"
+#include "framebuffer.h"
+#include "comando.h"
+#include "compositor.h"
+#include "cor.h"
+#include "fluxo.h"
+#include "gerador.h"
+#include "layout.h"
+#include "reprodutor.h"
+#include "tela.h"
+#include "texto.h"
+
+static const char *nomes_efeitos[NUM_EFEITOS] = {
+    "gradiente", "fade", "pisca", "espiral", "barras",
+    "lorenzo", "musica", "sirene", "contagem", "personalizado"
+};
+
+static uint sms_matriz[NUM_FAIXAS];
+static uint32_t *saida_quadros;
+static size_t capacidade_saida;
+static volatile uint32_t sorvedouro;
+
+static uint64_t relogio_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Roda o efeito até o fim em tempo virtual; retorna a duração virtual em µs
+static uint64_t rodar_efeito(Efeito efeito) {
+    uint64_t inicio = hal_fake_tempo_us();
+    comando_executar(COMANDO(CMD_EFEITO, efeito));
+    while (hal_fake_proximo_alarme()) {
+    }
+    return hal_fake_tempo_us() - inicio;
+}
+
+// Junta a saída gravada das faixas na ordem do framebuffer: em cada quadro,
+// os pixels da faixa 0, depois os da faixa 1, e assim por diante
+static const uint32_t *coletar_saida(size_t *quantidade) {
+    size_t n;
+    hal_fake_saida(pio0, sms_matriz[0], &n);
+    size_t quadros = n / PIXELS_POR_FAIXA;
+    if (quadros * NUM_PIXELS > capacidade_saida) {
+        capacidade_saida = quadros * NUM_PIXELS;
+        saida_quadros = realloc(saida_quadros, capacidade_saida * sizeof(uint32_t));
+    }
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        const uint32_t *faixa = hal_fake_saida(pio0, sms_matriz[k], &n);
+        for (size_t q = 0; q < quadros; q++) {
+            memcpy(&saida_quadros[q * NUM_PIXELS + k * PIXELS_POR_FAIXA],
+                   &faixa[q * PIXELS_POR_FAIXA], PIXELS_POR_FAIXA * sizeof(uint32_t));
+        }
+    }
+    *quantidade = quadros * NUM_PIXELS;
+    return saida_quadros;
+}
+
+static void medir_matrix_rgb(int iteracoes) {
+    uint32_t acumulado = 0;
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            acumulado ^= matrix_rgb(i, n, n + i);
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    sorvedouro = acumulado;
+    printf("%-16s %10.2f ns/pixel\n", "matrix_rgb", (double)(t1 - t0) / ((double)iteracoes * NUM_PIXELS));
+}
+
+static void medir_cor_grb(int iteracoes) {
+    uint32_t acumulado = 0;
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            acumulado ^= cor_grb(i, n, n + i);
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    sorvedouro = acumulado;
+    printf("%-16s %10.2f ns/pixel\n", "cor_grb", (double)(t1 - t0) / ((double)iteracoes * NUM_PIXELS));
+}
+
+static void medir_desenho_pio(int iteracoes) {
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        desenho_pio(n, n >> 1, n >> 2);
+        // Sem isso a gravação da saída cresceria a cada iteração
+        if ((n & 1023) == 1023) {
+            hal_fake_limpar_saida();
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    hal_fake_limpar_saida();
+    printf("%-16s %10.2f ns/pixel\n", "desenho_pio", (double)(t1 - t0) / ((double)iteracoes * NUM_PIXELS));
+}
+
+// Referência canal a canal das misturas do compositor, com as mesmas fórmulas
+// das versões em pistas: serve de medida de base e de prova de igualdade
+static uint32_t canal(uint32_t p, int deslocamento) {
+    return (p >> deslocamento) & 0xFF;
+}
+
+static void misturar_canais(ModoMistura modo, uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa) {
+    uint32_t w = alfa + (alfa >> 7);
+    for (int i = 0; i < n; i++) {
+        uint32_t k = 256 - (((256 - (canal(camada[i], 24) + (canal(camada[i], 24) >> 7))) * w) >> 8);
+        uint32_t p = 0;
+        for (int d = 8; d <= 24; d += 8) {
+            uint32_t a = canal(destino[i], d), b = canal(camada[i], d), c;
+            switch (modo) {
+                case MISTURA_NORMAL:
+                    c = (a * (256 - w) + b * w) >> 8;
+                    break;
+                case MISTURA_SOMA:
+                    c = a + ((b * w) >> 8);
+                    c = c > 255 ? 255 : c;
+                    break;
+                default:
+                    c = (a * k) >> 8;
+                    break;
+            }
+            p |= c << d;
+        }
+        destino[i] = p;
+    }
+}
+
+typedef void (*mistura_t)(uint32_t *destino, const uint32_t *camada, int n, uint8_t alfa);
+
+// Mede a mistura canal a canal e a em pistas sobre os mesmos dados, e confere
+// que as duas dão o mesmo resultado para todas as opacidades
+static bool medir_mistura(const char *nome, ModoMistura modo, mistura_t mistura, int iteracoes) {
+    static uint32_t fundo[NUM_PIXELS], camada[NUM_PIXELS], esperado[NUM_PIXELS], obtido[NUM_PIXELS];
+    uint32_t semente = 12345;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        semente = semente * 1103515245u + 12345u;
+        fundo[i] = semente & 0xFFFFFF00u;
+        semente = semente * 1103515245u + 12345u;
+        camada[i] = semente & 0xFFFFFF00u;
+    }
+
+    bool igual = true;
+    for (int alfa = 0; alfa < 256; alfa++) {
+        memcpy(esperado, fundo, sizeof(fundo));
+        memcpy(obtido, fundo, sizeof(fundo));
+        misturar_canais(modo, esperado, camada, NUM_PIXELS, alfa);
+        mistura(obtido, camada, NUM_PIXELS, alfa);
+        igual = igual && !memcmp(esperado, obtido, sizeof(obtido));
+    }
+
+    memcpy(esperado, fundo, sizeof(fundo));
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        misturar_canais(modo, esperado, camada, NUM_PIXELS, n);
+    }
+    uint64_t t1 = relogio_ns();
+    memcpy(obtido, fundo, sizeof(fundo));
+    for (int n = 0; n < iteracoes; n++) {
+        mistura(obtido, camada, NUM_PIXELS, n);
+    }
+    uint64_t t2 = relogio_ns();
+    sorvedouro = esperado[0] ^ obtido[0];
+
+    double canais = (double)(t1 - t0) / ((double)iteracoes * NUM_PIXELS);
+    double pistas = (double)(t2 - t1) / ((double)iteracoes * NUM_PIXELS);
+    printf("%-16s %10.2f ns/pixel (canal a canal %.2f, %.1fx) %s\n", nome, pistas, canais,
+           pistas > 0 ? canais / pistas : 0.0, igual ? "ok" : "DIFERENTE");
+    return igual;
+}
+
+// Decodificação de um fluxo comprimido completo, quadro a quadro
+static void medir_fluxo(const char *nome, const Animacao *anim, int iteracoes) {
+    static uint8_t quadro[NUM_PIXELS];
+    Fluxo f;
+    uint32_t pixels = 0;
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        fluxo_iniciar(&f, anim->fluxo, anim->tamanho_fluxo);
+        while (fluxo_proximo(&f, quadro)) {
+            pixels += f.num_pixels;
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    sorvedouro = quadro[0];
+    printf("%-16s %10.2f ns/pixel (%u bytes para %u quadros)\n", nome, (double)(t1 - t0) / pixels,
+           anim->tamanho_fluxo, f.num_frames);
+}
+
+// Cálculo de todos os quadros de uma animação procedural
+static void medir_gerador(const char *nome, const Animacao *anim, int iteracoes) {
+    static uint8_t quadro[NUM_PIXELS];
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        for (int frame = 0; frame < anim->num_frames; frame++) {
+            gerador_desenhar(anim->gerador, frame, quadro);
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    sorvedouro = quadro[0];
+    printf("%-16s %10.2f ns/pixel\n", nome,
+           (double)(t1 - t0) / ((double)iteracoes * anim->num_frames * MATRIZ_LARGURA * MATRIZ_ALTURA));
+}
+
+// Rasterização de uma mensagem inteira, quadro a quadro da rolagem
+static void medir_texto(const Texto *texto, int iteracoes) {
+    static uint32_t quadro[NUM_PIXELS];
+    Tela tela = tela_matriz(quadro);
+    int quadros = texto_num_quadros(texto);
+    uint64_t t0 = relogio_ns();
+    for (int n = 0; n < iteracoes; n++) {
+        for (int frame = 0; frame < quadros; frame++) {
+            texto_desenhar(texto, texto_posicao(texto, frame), &tela);
+        }
+    }
+    uint64_t t1 = relogio_ns();
+    sorvedouro = quadro[0];
+    printf("%-16s %10.2f ns/pixel (%d quadros)\n", "texto",
+           (double)(t1 - t0) / ((double)iteracoes * quadros * MATRIZ_LARGURA * MATRIZ_ALTURA), quadros);
+}
+
+// Confere que a tabela de cada rotação e espelhamento do layout atual leva
+// cada pixel da imagem a um LED diferente
+static bool conferir_layouts(void) {
+    static uint16_t mapa[NUM_PIXELS];
+    static bool usado[NUM_PIXELS];
+    bool ok = true;
+    for (int variante = 0; variante < 16; variante++) {
+        Layout layout = layout_matriz;
+        layout.rotacao = variante & 3;
+        layout.espelhar_x = variante & 4;
+        layout.espelhar_y = variante & 8;
+        layout_mapa(&layout, mapa);
+        memset(usado, 0, sizeof(usado));
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            if (mapa[i] >= NUM_PIXELS || usado[mapa[i]]) {
+                printf("layout: rotação %d, espelhar %d/%d leva o pixel %d ao LED %u repetido\n",
+                       layout.rotacao, layout.espelhar_x, layout.espelhar_y, i, mapa[i]);
+                ok = false;
+                break;
+            }
+            usado[mapa[i]] = true;
+        }
+    }
+    return ok;
+}
+
+#define TELA_TESTE 5
+
+// Compara a tela com o desenho esperado, uma string por linha: '.' é 0 e
+// um dígito é a própria cor
+static bool comparar_tela(const char *nome, const Tela *tela, const char *const esperado[TELA_TESTE]) {
+    for (int y = 0; y < TELA_TESTE; y++) {
+        for (int x = 0; x < TELA_TESTE; x++) {
+            char c = esperado[y][x];
+            uint32_t cor = c == '.' ? 0 : (uint32_t)(c - '0');
+            if (tela_ler(tela, x, y) != cor) {
+                printf("tela: %s tem %u em (%d, %d), esperado %u\n", nome, tela_ler(tela, x, y), x, y, cor);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Confere as linhas e as cópias recortadas de tela.h numa tela 5x5 contra
+// os pixels esperados
+static bool conferir_tela(void) {
+    static const struct {
+        const char *nome;
+        int x0, y0, x1, y1;
+        const char *esperado[TELA_TESTE];
+    } linhas[] = {
+        { "linha diagonal", 0, 0, 4, 4, { "1....", ".1...", "..1..", "...1.", "....1" } },
+        { "linha íngreme", 1, 0, 2, 4, { ".1...", ".1...", "..1..", "..1..", "..1.." } },
+        { "linha invertida", 4, 3, 0, 1, { ".....", "11...", "..11.", "....1", "....." } },
+        { "linha fora da tela", -2, 4, 6, 4, { ".....", ".....", ".....", ".....", "11111" } },
+    };
+    static const uint32_t imagem[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    static const struct {
+        const char *nome;
+        int x, y;
+        const char *esperado[TELA_TESTE];
+    } copias[] = {
+        { "cópia na borda esquerda", -1, 1, { ".....", "23...", "56...", "89...", "....." } },
+        { "cópia na borda de cima", 1, -2, { ".789.", ".....", ".....", ".....", "....." } },
+        { "cópia na borda direita", 3, 0, { "...12", "...45", "...78", ".....", "....." } },
+        { "cópia na borda de baixo", 2, 3, { ".....", ".....", ".....", "..123", "..456" } },
+        { "cópia no canto", -1, -1, { "56...", "89...", ".....", ".....", "....." } },
+        { "cópia fora da tela", 5, 0, { ".....", ".....", ".....", ".....", "....." } },
+    };
+
+    uint32_t pixels[TELA_TESTE * TELA_TESTE];
+    Tela tela = { pixels, TELA_TESTE, TELA_TESTE };
+    bool ok = true;
+    for (int i = 0; i < (int)count_of(linhas); i++) {
+        tela_preencher(&tela, 0);
+        tela_linha(&tela, linhas[i].x0, linhas[i].y0, linhas[i].x1, linhas[i].y1, 1);
+        ok &= comparar_tela(linhas[i].nome, &tela, linhas[i].esperado);
+    }
+    for (int i = 0; i < (int)count_of(copias); i++) {
+        tela_preencher(&tela, 0);
+        tela_copiar(&tela, copias[i].x, copias[i].y, imagem, 3, 3);
+        ok &= comparar_tela(copias[i].nome, &tela, copias[i].esperado);
+    }
+    return ok;
+}
+
+static bool gravar_arquivo(const char *caminho, const uint32_t *dados, size_t quantidade) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) {
+        printf("Erro ao criar %s: %s\n", caminho, strerror(errno));
+        return false;
+    }
+    // Palavras GRB em little-endian, uma por pixel transmitido
+    for (size_t i = 0; i < quantidade; i++) {
+        uint8_t b[4] = {dados[i], dados[i] >> 8, dados[i] >> 16, dados[i] >> 24};
+        fwrite(b, 1, 4, f);
+    }
+    fclose(f);
+    return true;
+}
+
+static bool comparar_arquivo(const char *caminho, const uint32_t *dados, size_t quantidade) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        printf("  golden ausente: %s\n", caminho);
+        return false;
+    }
+    size_t i = 0;
+    uint8_t b[4];
+    bool igual = true;
+    while (fread(b, 1, 4, f) == 4) {
+        uint32_t esperado = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+        if (i >= quantidade) {
+            i++;
+            igual = false;
+            continue;
+        }
+        if (igual && dados[i] != esperado) {
+            printf("  diferença no quadro %zu, pixel %zu: 0x%08x (golden 0x%08x)\n",
+                   i / NUM_PIXELS, i % NUM_PIXELS, dados[i], esperado);
+            igual = false;
+        }
+        i++;
+    }
+    fclose(f);
+    if (i != quantidade) {
+        printf("  %zu pixels gravados, golden tem %zu\n", quantidade, i);
+        igual = false;
+    }
+    return igual;
+}
+
+int main(int argc, char **argv) {
+    int iteracoes = 200;
+    const char *pasta_saida = NULL;
+    const char *pasta_golden = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            iteracoes = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            pasta_saida = argv[++i];
+        } else if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            pasta_golden = argv[++i];
+        } else {
+            printf("Uso: %s [-n iterações] [-o pasta_saida] [-g pasta_golden]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iteracoes < 1) {
+        iteracoes = 1;
+    }
+    if (pasta_saida && mkdir(pasta_saida, 0755) != 0 && errno != EEXIST) {
+        printf("Erro ao criar %s: %s\n", pasta_saida, strerror(errno));
+        return 2;
+    }
+
+    hal_fake_reiniciar();
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        sms_matriz[k] = pio_claim_unused_sm(pio0, true);
+    }
+    framebuffer_init(pio0, sms_matriz);
+    comando_init();
+
+    // 24 bits de 1,25 µs por LED, mais o reset de 50 µs; as faixas são
+    // transmitidas em paralelo
+    printf("%d faixa(s) x %d LEDs: %.1f µs por quadro na linha de dados\n\n",
+           NUM_FAIXAS, PIXELS_POR_FAIXA, PIXELS_POR_FAIXA * 24 * 1.25 + 50);
+
+    printf("== Funções de desenho (%d iterações x 100) ==\n", iteracoes);
+    medir_matrix_rgb(iteracoes * 100);
+    medir_cor_grb(iteracoes * 100);
+    medir_desenho_pio(iteracoes * 100);
+    medir_fluxo("fluxo musica", &animacao_6_musica, iteracoes * 10);
+    medir_fluxo("fluxo Felipe", &animacao_9_Felipe, iteracoes * 10);
+    medir_gerador("ger. gradiente", &animacao_0, iteracoes * 10);
+    medir_gerador("ger. fade", &animacao_1, iteracoes * 10);
+    medir_gerador("ger. espiral", &animacao_3_espiral_LUIZ, iteracoes * 10);
+    medir_gerador("ger. barras", &animacao_4, iteracoes * 10);
+    medir_texto(&texto_lorenzo, iteracoes);
+
+    printf("\n== Mistura de camadas (%d iterações x 100) ==\n", iteracoes);
+    int falhas = !conferir_layouts();
+    falhas += !conferir_tela();
+    falhas += !medir_mistura("mistura normal", MISTURA_NORMAL, misturar_normal, iteracoes * 100);
+    falhas += !medir_mistura("mistura soma", MISTURA_SOMA, misturar_soma, iteracoes * 100);
+    falhas += !medir_mistura("mistura máscara", MISTURA_MASCARA, misturar_mascara, iteracoes * 100);
+
+    printf("\n== Efeitos (%d execuções; inclui agendador, buzzer e HAL falso) ==\n", iteracoes);
+    printf("%-16s %8s %9s %10s %12s %8s\n", "efeito", "quadros", "repetidos", "duração", "ns/pixel", "golden");
+
+    for (int e = 0; e < NUM_EFEITOS; e++) {
+        // Primeira execução: grava a saída para o arquivo e para a comparação
+        hal_fake_limpar_saida();
+        framebuffer_zerar_estatisticas();
+        uint64_t duracao_us = rodar_efeito(e);
+        EstatisticasFramebuffer quadros;
+        framebuffer_estatisticas(&quadros);
+        size_t quantidade;
+        const uint32_t *saida = coletar_saida(&quantidade);
+
+        const char *resultado = "-";
+        char caminho[512];
+        if (pasta_saida) {
+            snprintf(caminho, sizeof(caminho), "%s/%s.grb", pasta_saida, nomes_efeitos[e]);
+            if (!gravar_arquivo(caminho, saida, quantidade)) {
+                return 2;
+            }
+        }
+        if (pasta_golden) {
+            snprintf(caminho, sizeof(caminho), "%s/%s.grb", pasta_golden, nomes_efeitos[e]);
+            if (comparar_arquivo(caminho, saida, quantidade)) {
+                resultado = "ok";
+            } else {
+                resultado = "FALHOU";
+                falhas++;
+            }
+        }
+        size_t pixels = quantidade;
+
+        uint64_t t0 = relogio_ns();
+        for (int n = 0; n < iteracoes; n++) {
+            hal_fake_limpar_saida();
+            rodar_efeito(e);
+        }
+        uint64_t t1 = relogio_ns();
+
+        printf("%-16s %8zu %9u %8.2f s %12.2f %8s\n", nomes_efeitos[e], pixels / NUM_PIXELS,
+               quadros.repetidos, duracao_us / 1e6, (double)(t1 - t0) / ((double)iteracoes * (pixels ? pixels : 1)), resultado);
+    }
+    hal_fake_limpar_saida();
+
+    if (pasta_golden) {
+        printf("\n%s\n", falhas ? "Saída diferente do golden." : "Saída igual ao golden.");
+    }
+    return falhas ? 1 : 0;
+}
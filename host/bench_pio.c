@@ -0,0 +1,287 @@
+// Teste do programa matriz_led.pio em um emulador de PIO (pio_emulador.h).
+//
+// Monta o .pio, configura a state machine como matriz_led_program_init()
+// (divisor clk_sys / 8 MHz, autopull de 24 bits deslocando para a
+// esquerda) e alimenta a FIFO com palavras GRB, como o DMA. A forma de
+// onda do pino é medida ciclo a ciclo do clk_sys e conferida com os limites
+// do WS2812: cada bit é decodificado de volta e comparado com o enviado, e
+// os tempos alto/baixo de cada bit precisam ficar dentro da tolerância.
+// Vários quadros seguem sem pausa: o programa precisa manter a linha baixa
+// pelo reset entre eles e só levantar a flag de fim de quadro depois dele.
+// Roda em vários clk_sys e mostra a taxa de bits e de quadros em cada um.
+//
+// Uso: bench_pio [-p matriz_led.pio] [clk_sys em MHz ...]
+//
+// Termina com erro se algum clock violar os tempos ou corromper os dados.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pio_emulador.h"
+
+#ifndef MATRIZ_PIO
+#define MATRIZ_PIO "matriz_led.pio"
+#endif
+
+// Limites do WS2812B em ns (datasheet: 0,4/0,85 µs e 0,8/0,45 µs, ± 150 ns)
+#define T0H_MIN 250
+#define T0H_MAX 550
+#define T1H_MIN 650
+#define T1H_MAX 950
+#define T0L_MIN 700
+#define T0L_MAX 1000
+#define T1L_MIN 300
+#define T1L_MAX 600
+#define RESET_MIN_US 50
+
+// Mesma configuração de matriz_led_program_init()
+#define FREQ_PIO 8000000.0
+#define BITS_POR_PIXEL 24
+
+// Quadros de PIXELS_QUADRO pixels, um atrás do outro como o DMA entregaria
+#define PIXELS_QUADRO 64
+#define NUM_QUADROS 3
+#define NUM_PALAVRAS (PIXELS_QUADRO * NUM_QUADROS)
+#define BITS_QUADRO (PIXELS_QUADRO * BITS_POR_PIXEL)
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    uint32_t min_ns, max_ns;
+} Faixa;
+
+static void faixa_registrar(Faixa *f, uint32_t ns) {
+    if (ns < f->min_ns) {
+        f->min_ns = ns;
+    }
+    if (ns > f->max_ns) {
+        f->max_ns = ns;
+    }
+}
+
+static bool faixa_dentro(const Faixa *f, uint32_t min_ns, uint32_t max_ns) {
+    return f->max_ns == 0 || (f->min_ns >= min_ns && f->max_ns <= max_ns);
+}
+
+// Padrões fixos nos extremos e o resto pseudoaleatório, sempre em GRB << 8
+static void gerar_palavras(uint32_t *palavras) {
+    static const uint32_t fixos[] = { 0x000000, 0xFFFFFF, 0xAAAAAA, 0x555555, 0xF0F0F0, 0x0F0F0F, 0x800001 };
+    uint32_t estado = 0x12345678;
+    for (int i = 0; i < NUM_PALAVRAS; i++) {
+        estado = estado * 1664525u + 1013904223u;
+        uint32_t grb = i < (int)count_of(fixos) ? fixos[i] : estado >> 8;
+        palavras[i] = grb << 8;
+    }
+}
+
+typedef struct {
+    Faixa t0h, t0l, t1h, t1l;
+    Faixa reset_ns;         // Linha baixa entre o último bit de um quadro e o seguinte
+    Faixa irq_ns;           // Do último bit de cada quadro até a flag de fim de quadro
+    uint32_t bits, erros;
+    uint32_t irqs, irqs_fora;  // Flags levantadas e as que vieram antes do quadro acabar
+    double bits_por_s;
+    double quadros_por_s;
+    uint64_t ciclos_parada;
+    bool reset_baixo;
+} Resultado;
+
+// Mesma sequência de matriz_led_program_init(): bits por quadro menos 1 na ISR
+static bool carregar_quadro(MaquinaPio *sm) {
+    uint16_t pull, out_isr;
+    if (!pio_montar_instrucao("pull block", &pull) || !pio_montar_instrucao("out isr, 32", &out_isr)) {
+        return false;
+    }
+    pio_colocar(sm, BITS_QUADRO - 1);
+    return pio_executar(sm, pull) && pio_executar(sm, out_isr);
+}
+
+static bool testar_clock(const ProgramaPio *prog, double clk_hz, Resultado *r) {
+    static uint32_t palavras[NUM_PALAVRAS];
+    gerar_palavras(palavras);
+
+    MaquinaPio sm;
+    pio_iniciar(&sm, prog, (float)(clk_hz / FREQ_PIO), BITS_POR_PIXEL);
+
+    memset(r, 0, sizeof(*r));
+    r->t0h.min_ns = r->t0l.min_ns = r->t1h.min_ns = r->t1l.min_ns = UINT32_MAX;
+    r->reset_ns.min_ns = r->irq_ns.min_ns = UINT32_MAX;
+    if (!carregar_quadro(&sm)) {
+        return false;
+    }
+
+    const uint32_t total_bits = NUM_PALAVRAS * BITS_POR_PIXEL;
+    double ns_por_ciclo = 1e9 / clk_hz;
+    int colocadas = 0;
+    bool nivel = false;
+    uint64_t subida = 0, descida = 0, primeira_subida = 0, ultima_subida_quadro = 0;
+    uint64_t primeira_irq = 0, ultima_irq = 0;
+    uint64_t parada_dados = 0;
+    uint64_t ultimo_evento = 0;
+
+    // Alimenta a FIFO sempre que há espaço (como o DREQ do DMA), sem pausa
+    // entre os quadros, e segue até a flag do último quadro
+    while (r->irqs < NUM_QUADROS) {
+        while (colocadas < NUM_PALAVRAS && pio_colocar(&sm, palavras[colocadas])) {
+            colocadas++;
+        }
+        bool novo = pio_ciclo(&sm);
+        uint64_t agora = sm.ciclos_sys;
+
+        if (novo && !nivel) {
+            // Subida: fecha o bit anterior (alto de subida a descida, baixo até
+            // aqui). Depois do último bit de um quadro o baixo é o reset.
+            if (r->bits > 0) {
+                uint32_t alto = (uint32_t)((descida - subida) * ns_por_ciclo + 0.5);
+                uint32_t baixo = (uint32_t)((agora - descida) * ns_por_ciclo + 0.5);
+                if (r->bits % BITS_QUADRO == 0) {
+                    faixa_registrar(&r->reset_ns, baixo);
+                } else {
+                    faixa_registrar(alto > (T0H_MAX + T1H_MIN) / 2 ? &r->t1l : &r->t0l, baixo);
+                }
+            } else {
+                primeira_subida = agora;
+            }
+            if (r->bits < BITS_QUADRO) {
+                ultima_subida_quadro = agora;
+            }
+            subida = agora;
+        } else if (!novo && nivel) {
+            descida = agora;
+            uint32_t alto = (uint32_t)((descida - subida) * ns_por_ciclo + 0.5);
+            bool um = alto > (T0H_MAX + T1H_MIN) / 2;
+            faixa_registrar(um ? &r->t1h : &r->t0h, alto);
+
+            uint32_t palavra = palavras[r->bits / BITS_POR_PIXEL];
+            bool esperado = (palavra >> (31 - r->bits % BITS_POR_PIXEL)) & 1;
+            if (um != esperado) {
+                r->erros++;
+            }
+            r->bits++;
+            ultimo_evento = agora;
+            if (r->bits == total_bits) {
+                parada_dados = sm.ciclos_parada;
+            }
+        }
+        nivel = novo;
+
+        // Fim de quadro: a flag da state machine só pode subir depois do
+        // último bit do quadro e do reset
+        uint8_t flag = 1u << sm.indice;
+        if (sm.irq & flag) {
+            sm.irq &= ~flag;
+            r->irqs++;
+            if (r->bits != r->irqs * BITS_QUADRO) {
+                r->irqs_fora++;
+            }
+            faixa_registrar(&r->irq_ns, (uint32_t)((agora - descida) * ns_por_ciclo + 0.5));
+            if (r->irqs == 1) {
+                primeira_irq = agora;
+            }
+            ultima_irq = agora;
+            ultimo_evento = agora;
+        }
+
+        // Nenhum bit nem flag por 1 ms: o programa parou
+        if (agora - ultimo_evento > (uint64_t)(clk_hz / 1000)) {
+            return false;
+        }
+    }
+
+    // Taxa dentro do quadro: o último bit termina quando o seguinte
+    // começaria, um período depois da última subida, pela média dos anteriores
+    double periodo = (double)(ultima_subida_quadro - primeira_subida) / (BITS_QUADRO - 1);
+    r->bits_por_s = clk_hz / periodo;
+    r->quadros_por_s = clk_hz * (NUM_QUADROS - 1) / (double)(ultima_irq - primeira_irq);
+    r->reset_baixo = !nivel;
+    // Paradas antes do último bit indicam FIFO vazia com dados pendentes;
+    // não deveria haver nenhuma com a FIFO sempre cheia
+    r->ciclos_parada = parada_dados;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *caminho = MATRIZ_PIO;
+    double clocks_mhz[32];
+    int num_clocks = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            caminho = argv[++i];
+        } else if (argv[i][0] != '-' && num_clocks < (int)count_of(clocks_mhz)) {
+            clocks_mhz[num_clocks++] = atof(argv[i]);
+        } else {
+            fprintf(stderr, "Uso: %s [-p programa.pio] [clk_sys em MHz ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_clocks == 0) {
+        static const double padrao[] = { 48, 100, 125, 133, 150, 200, 250, 270 };
+        memcpy(clocks_mhz, padrao, sizeof(padrao));
+        num_clocks = count_of(padrao);
+    }
+
+    ProgramaPio prog;
+    if (!pio_montar(caminho, &prog)) {
+        return 2;
+    }
+    printf("%s: %d instruções, wrap %d..%d\n", caminho, prog.tamanho, prog.wrap_target, prog.wrap);
+    printf("Limites (ns): T0H %d-%d, T0L %d-%d, T1H %d-%d, T1L %d-%d\n\n",
+           T0H_MIN, T0H_MAX, T0L_MIN, T0L_MAX, T1H_MIN, T1H_MAX, T1L_MIN, T1L_MAX);
+    printf("Quadros de %d LEDs, %d seguidos com a FIFO sempre cheia; reset mínimo %d µs\n\n",
+           PIXELS_QUADRO, NUM_QUADROS, RESET_MIN_US);
+    printf("%8s %10s %10s %10s %10s %10s %10s %9s %10s %8s\n",
+           "clk MHz", "divisor", "kbit/s", "T0H ns", "T0L ns", "T1H ns", "T1L ns", "reset µs", "quadros/s", "");
+
+    int falhas = 0;
+    for (int c = 0; c < num_clocks; c++) {
+        double clk_hz = clocks_mhz[c] * 1e6;
+        uint16_t div_int;
+        uint8_t div_frac;
+        pio_divisor((float)(clk_hz / FREQ_PIO), &div_int, &div_frac);
+
+        Resultado r;
+        bool ok = testar_clock(&prog, clk_hz, &r);
+        if (!ok) {
+            printf("%8.1f %6u+%3u  parou depois de %u de %u bits e %u de %d quadros\n", clocks_mhz[c],
+                   div_int, div_frac, r.bits, NUM_PALAVRAS * BITS_POR_PIXEL, r.irqs, NUM_QUADROS);
+            falhas++;
+            continue;
+        }
+
+        // O reset vale tanto entre quadros quanto até a flag de fim de quadro
+        bool reset_ok = r.reset_ns.min_ns >= RESET_MIN_US * 1000 && r.irq_ns.min_ns >= RESET_MIN_US * 1000;
+        ok = r.erros == 0 && r.ciclos_parada == 0 && r.reset_baixo && reset_ok && r.irqs_fora == 0 &&
+             faixa_dentro(&r.t0h, T0H_MIN, T0H_MAX) && faixa_dentro(&r.t0l, T0L_MIN, T0L_MAX) &&
+             faixa_dentro(&r.t1h, T1H_MIN, T1H_MAX) && faixa_dentro(&r.t1l, T1L_MIN, T1L_MAX);
+        printf("%8.1f %6u+%3u %10.1f %5u-%-4u %5u-%-4u %5u-%-4u %5u-%-4u %9.1f %10.1f %8s\n",
+               clocks_mhz[c], div_int, div_frac, r.bits_por_s / 1000,
+               r.t0h.min_ns, r.t0h.max_ns, r.t0l.min_ns, r.t0l.max_ns,
+               r.t1h.min_ns, r.t1h.max_ns, r.t1l.min_ns, r.t1l.max_ns,
+               r.reset_ns.min_ns / 1000.0, r.quadros_por_s, ok ? "ok" : "FORA");
+        if (r.erros) {
+            printf("  %u de %u bits decodificados errado\n", r.erros, r.bits);
+        }
+        if (r.ciclos_parada) {
+            printf("  %llu ciclos parados no autopull com a FIFO alimentada\n",
+                   (unsigned long long)r.ciclos_parada);
+        }
+        if (!reset_ok) {
+            printf("  reset de %.1f µs entre quadros e %.1f µs até a flag de fim de quadro\n",
+                   r.reset_ns.min_ns / 1000.0, r.irq_ns.min_ns / 1000.0);
+        }
+        if (r.irqs_fora) {
+            printf("  %u flag(s) de fim de quadro antes do último bit\n", r.irqs_fora);
+        }
+        if (!r.reset_baixo) {
+            printf("  linha alta depois do último bit: sem reset\n");
+        }
+        if (!ok) {
+            falhas++;
+        }
+    }
+
+    printf("\n%s\n", falhas ? "Há clocks fora dos limites do WS2812." : "Todos os clocks dentro dos limites.");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,341 @@
+// Codificador de animações para o formato comprimido de fluxo.h.
+//
+// Lê um arquivo de texto com diretivas e quadros e gera um arquivo C com o
+// fluxo e a struct Animacao correspondente:
+//
+//   nome animacao_9_Felipe     nome da variável Animacao gerada
+//   cor 0 255 255              cor (R G B) da animação
+//   fps 5                      taxa de quadros
+//   chave 64                   quadro-chave a cada N quadros (0: só o primeiro)
+//   0 0 255 0 ...              um quadro por linha: intensidades de 0 a 255
+//
+// '#' inicia um comentário. Depois de gerar, o fluxo é decodificado com o
+// mesmo fluxo.c do firmware e comparado com a entrada.
+//
+// Uso: codificador_fluxo entrada.txt [-o saida.c]
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fluxo.h"
+
+typedef struct {
+    uint8_t *dados;
+    size_t tamanho, capacidade;
+} Buffer;
+
+static void buffer_byte(Buffer *b, uint8_t valor) {
+    if (b->tamanho == b->capacidade) {
+        b->capacidade = b->capacidade ? b->capacidade * 2 : 4096;
+        b->dados = realloc(b->dados, b->capacidade);
+        if (!b->dados) {
+            fprintf(stderr, "Erro: sem memória.\n");
+            exit(1);
+        }
+    }
+    b->dados[b->tamanho++] = valor;
+}
+
+static void buffer_bytes(Buffer *b, const uint8_t *valores, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        buffer_byte(b, valores[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Entrada
+
+typedef struct {
+    char nome[128];
+    uint8_t r, g, b;
+    uint fps;
+    uint intervalo_chave;
+    uint num_pixels;
+    uint num_frames;
+    Buffer quadros; // num_frames * num_pixels bytes
+} Entrada;
+
+static bool ler_entrada(const char *caminho, Entrada *e) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir %s\n", caminho);
+        return false;
+    }
+
+    char linha[16384];
+    int numero_linha = 0;
+    bool ok = true;
+    while (ok && fgets(linha, sizeof(linha), f)) {
+        numero_linha++;
+        char *comentario = strchr(linha, '#');
+        if (comentario) {
+            *comentario = '\0';
+        }
+        char *p = linha;
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p == '\0') {
+            continue;
+        }
+
+        if (isalpha((unsigned char)*p)) {
+            unsigned r, g, b;
+            if (sscanf(p, "nome %127s", e->nome) == 1) {
+            } else if (sscanf(p, "cor %u %u %u", &r, &g, &b) == 3 && r < 256 && g < 256 && b < 256) {
+                e->r = r;
+                e->g = g;
+                e->b = b;
+            } else if (sscanf(p, "fps %u", &e->fps) == 1 && e->fps > 0) {
+            } else if (sscanf(p, "chave %u", &e->intervalo_chave) == 1) {
+            } else {
+                fprintf(stderr, "%s:%d: diretiva inválida\n", caminho, numero_linha);
+                ok = false;
+            }
+            continue;
+        }
+
+        // Linha de quadro: valores separados por espaços ou vírgulas
+        uint pixels = 0;
+        while (*p) {
+            if (isspace((unsigned char)*p) || *p == ',') {
+                p++;
+                continue;
+            }
+            char *fim;
+            long valor = strtol(p, &fim, 10);
+            if (fim == p || valor < 0 || valor > 255) {
+                fprintf(stderr, "%s:%d: valor inválido\n", caminho, numero_linha);
+                ok = false;
+                break;
+            }
+            buffer_byte(&e->quadros, (uint8_t)valor);
+            pixels++;
+            p = fim;
+        }
+        if (!ok) {
+            break;
+        }
+        if (e->num_frames == 0) {
+            e->num_pixels = pixels;
+        } else if (pixels != e->num_pixels) {
+            fprintf(stderr, "%s:%d: quadro com %u pixels, esperado %u\n", caminho, numero_linha, pixels, e->num_pixels);
+            ok = false;
+        }
+        e->num_frames++;
+    }
+    fclose(f);
+
+    if (ok && (e->nome[0] == '\0' || e->fps == 0 || e->num_frames == 0)) {
+        fprintf(stderr, "%s: nome, fps e pelo menos um quadro são obrigatórios\n", caminho);
+        ok = false;
+    }
+    if (ok && (e->num_pixels > 0xFFFF || e->num_frames > 0xFFFF)) {
+        fprintf(stderr, "%s: no máximo 65535 pixels e 65535 quadros\n", caminho);
+        ok = false;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Codificação
+
+// Tamanho da sequência de valores iguais a partir de v[0], até o limite
+static uint repeticoes(const uint8_t *v, uint n, uint limite) {
+    uint r = 1;
+    while (r < n && r < limite && v[r] == v[0]) {
+        r++;
+    }
+    return r;
+}
+
+// Emite um salto de delta: bytes 255 de continuação e um byte final menor
+static void emitir_salto(Buffer *out, uint salto) {
+    while (salto >= 255) {
+        buffer_byte(out, 255);
+        salto -= 255;
+    }
+    buffer_byte(out, salto);
+}
+
+// Codifica v[0..n) em pacotes RLE. Em um delta, cada pacote vem depois de
+// um salto: o primeiro com salto_inicial e os seguintes com zero.
+static void codificar_rle(Buffer *out, const uint8_t *v, uint n, bool com_salto, uint salto_inicial) {
+    uint i = 0;
+    while (i < n) {
+        if (com_salto) {
+            emitir_salto(out, salto_inicial);
+            salto_inicial = 0;
+        }
+        uint r = repeticoes(&v[i], n - i, 130);
+        if (r >= 3) {
+            buffer_byte(out, 125 + r);
+            buffer_byte(out, v[i]);
+            i += r;
+            continue;
+        }
+        // Literais até o início de uma sequência de 3 ou mais iguais
+        uint j = i;
+        while (j < n && j - i < 128 && repeticoes(&v[j], n - j, 3) < 3) {
+            j++;
+        }
+        buffer_byte(out, j - i - 1);
+        buffer_bytes(out, &v[i], j - i);
+        i = j;
+    }
+}
+
+static void codificar_chave(Buffer *out, const uint8_t *quadro, uint n) {
+    buffer_byte(out, FLUXO_CHAVE);
+    codificar_rle(out, quadro, n, false, 0);
+}
+
+static void codificar_delta(Buffer *out, const uint8_t *anterior, const uint8_t *quadro, uint n) {
+    buffer_byte(out, FLUXO_DELTA);
+    uint pos = 0;
+    while (pos < n) {
+        uint inicio = pos;
+        while (inicio < n && quadro[inicio] == anterior[inicio]) {
+            inicio++;
+        }
+        if (inicio == n) {
+            emitir_salto(out, n - pos);
+            return;
+        }
+        // Trechos de até 2 pixels iguais no meio de mudanças saem mais
+        // baratos como literais do que com um salto e um pacote novos
+        uint fim = inicio;
+        while (fim < n) {
+            if (quadro[fim] != anterior[fim]) {
+                fim++;
+                continue;
+            }
+            uint iguais = 0;
+            while (fim + iguais < n && iguais < 3 && quadro[fim + iguais] == anterior[fim + iguais]) {
+                iguais++;
+            }
+            if (iguais >= 3 || fim + iguais == n) {
+                break;
+            }
+            fim += iguais;
+        }
+        codificar_rle(out, &quadro[inicio], fim - inicio, true, inicio - pos);
+        pos = fim;
+    }
+}
+
+static void codificar(const Entrada *e, Buffer *out) {
+    uint n = e->num_pixels;
+    buffer_byte(out, n & 0xFF);
+    buffer_byte(out, n >> 8);
+    buffer_byte(out, e->num_frames & 0xFF);
+    buffer_byte(out, e->num_frames >> 8);
+
+    Buffer chave = {0}, delta = {0};
+    for (uint q = 0; q < e->num_frames; q++) {
+        const uint8_t *quadro = &e->quadros.dados[q * n];
+        const uint8_t *anterior = q ? quadro - n : NULL;
+        bool forcar_chave = q == 0 || (e->intervalo_chave && q % e->intervalo_chave == 0);
+
+        if (!forcar_chave && memcmp(quadro, anterior, n) == 0) {
+            buffer_byte(out, FLUXO_REPETE);
+            continue;
+        }
+        chave.tamanho = 0;
+        codificar_chave(&chave, quadro, n);
+        if (forcar_chave) {
+            buffer_bytes(out, chave.dados, chave.tamanho);
+            continue;
+        }
+        delta.tamanho = 0;
+        codificar_delta(&delta, anterior, quadro, n);
+        const Buffer *menor = delta.tamanho < chave.tamanho ? &delta : &chave;
+        buffer_bytes(out, menor->dados, menor->tamanho);
+    }
+    free(chave.dados);
+    free(delta.dados);
+}
+
+// Decodifica com o decodificador do firmware e compara com a entrada
+static bool verificar(const Entrada *e, const Buffer *codificado) {
+    Fluxo f;
+    uint8_t *quadro = calloc(e->num_pixels, 1);
+    bool ok = fluxo_iniciar(&f, codificado->dados, codificado->tamanho) &&
+              f.num_pixels == e->num_pixels && f.num_frames == e->num_frames;
+    for (uint q = 0; ok && q < e->num_frames; q++) {
+        if (!fluxo_proximo(&f, quadro) || memcmp(quadro, &e->quadros.dados[q * e->num_pixels], e->num_pixels) != 0) {
+            fprintf(stderr, "Erro: quadro %u decodificado diferente da entrada\n", q);
+            ok = false;
+        }
+    }
+    if (ok && f.pos != f.fim) {
+        fprintf(stderr, "Erro: sobraram bytes no fim do fluxo\n");
+        ok = false;
+    }
+    free(quadro);
+    return ok;
+}
+
+static void escrever_c(FILE *out, const char *caminho_entrada, const Entrada *e, const Buffer *codificado) {
+    fprintf(out, "// Gerado por host/codificador_fluxo a partir de %s; não editar.\n", caminho_entrada);
+    fprintf(out, "// %u quadros de %u pixels: %zu bytes (%u sem compressão)\n\n",
+            e->num_frames, e->num_pixels, codificado->tamanho, e->num_frames * e->num_pixels);
+    fprintf(out, "#include \"animacoes.h\"\n\n");
+    fprintf(out, "static const uint8_t fluxo_%s[] = {", e->nome);
+    for (size_t i = 0; i < codificado->tamanho; i++) {
+        fprintf(out, "%s0x%02x,", i % 12 ? " " : "\n    ", codificado->dados[i]);
+    }
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "const Animacao %s = {\n", e->nome);
+    fprintf(out, "    .fluxo = fluxo_%s,\n", e->nome);
+    fprintf(out, "    .tamanho_fluxo = sizeof(fluxo_%s),\n", e->nome);
+    fprintf(out, "    .num_frames = %u,\n", e->num_frames);
+    fprintf(out, "    .r = %u,\n    .g = %u,\n    .b = %u,\n", e->r, e->g, e->b);
+    fprintf(out, "    .periodo_us = PERIODO_FPS(%u)\n", e->fps);
+    fprintf(out, "};\n");
+}
+
+int main(int argc, char **argv) {
+    const char *caminho_entrada = NULL;
+    const char *caminho_saida = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            caminho_saida = argv[++i];
+        } else if (!caminho_entrada && argv[i][0] != '-') {
+            caminho_entrada = argv[i];
+        } else {
+            caminho_entrada = NULL;
+            break;
+        }
+    }
+    if (!caminho_entrada) {
+        fprintf(stderr, "Uso: %s entrada.txt [-o saida.c]\n", argv[0]);
+        return 2;
+    }
+
+    Entrada e = {0};
+    if (!ler_entrada(caminho_entrada, &e)) {
+        return 1;
+    }
+
+    Buffer codificado = {0};
+    codificar(&e, &codificado);
+    if (!verificar(&e, &codificado)) {
+        return 1;
+    }
+
+    FILE *out = caminho_saida ? fopen(caminho_saida, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Erro ao criar %s\n", caminho_saida);
+        return 1;
+    }
+    escrever_c(out, caminho_entrada, &e, &codificado);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    fprintf(stderr, "%s: %u quadros, %zu bytes (%.1f%% de %u)\n", e.nome, e.num_frames, codificado.tamanho,
+            100.0 * codificado.tamanho / ((double)e.num_frames * e.num_pixels), e.num_frames * e.num_pixels);
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Envia quadros para a matriz pela USB, no protocolo de protocolo.h.
+//
+// Os quadros são lidos de um arquivo ou da entrada padrão (pipe), cada um
+// com PIXELS palavras GRB de 32 bits little-endian, o mesmo formato dos
+// arquivos .grb gravados por bench_matriz. O envio é cadenciado na taxa
+// pedida e cada quadro leva o prazo em que deve aparecer.
+//
+// Uso: enviar_quadros [-d porta] [-p pixels] [-f fps] [-l] [arquivo.grb | -]
+//      enviar_quadros [-d porta] -e efeito
+//      enviar_quadros [-d porta] -o efeito
+//      enviar_quadros [-d porta] -b brilho
+//      enviar_quadros [-d porta] [-v colunas/s] -t mensagem
+//      enviar_quadros -d porta -s
+//
+//   -d  porta serial do Pico (por exemplo /dev/ttyACM0); sem ela, stdout
+//   -p  pixels por quadro (padrão 25)
+//   -f  quadros por segundo (padrão 60); 0 envia o mais rápido possível, sem prazo
+//   -l  repete o arquivo sem parar
+//   -e  inicia o efeito informado (0 a 9, como as teclas) e sai
+//   -o  soma o efeito informado por cima do que estiver na matriz e sai
+//   -b  muda o brilho global das animações (0 a 255) e sai
+//   -t  rola a mensagem na matriz (até TEXTO_MAX caracteres) e sai
+//   -v  velocidade da mensagem em colunas por segundo (padrão do firmware)
+//   -s  pede os contadores de desempenho (telemetria.h) e mostra a resposta
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pacote.h"
+#include "comando.h"
+
+static bool escrever_tudo(int fd, const uint8_t *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t n = write(fd, dados, tamanho);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Erro ao enviar: %s\n", strerror(errno));
+            return false;
+        }
+        dados += n;
+        tamanho -= n;
+    }
+    return true;
+}
+
+// Mostra o que o Pico escrever até ficar em silêncio por espera_ms
+static void mostrar_resposta(int fd, int espera_ms) {
+    char texto[256];
+    struct pollfd p = { .fd = fd, .events = POLLIN };
+    while (poll(&p, 1, espera_ms) > 0 && (p.revents & POLLIN)) {
+        ssize_t n = read(fd, texto, sizeof(texto));
+        if (n <= 0) {
+            break;
+        }
+        fwrite(texto, 1, n, stdout);
+    }
+}
+
+// Descarta o que o Pico escreveu (mensagens de printf) para a USB não travar
+static void descartar_entrada(int fd) {
+    uint8_t lixo[256];
+    struct pollfd p = { .fd = fd, .events = POLLIN };
+    while (poll(&p, 1, 0) > 0 && (p.revents & POLLIN) && read(fd, lixo, sizeof(lixo)) > 0) {
+    }
+}
+
+static int abrir_porta(const char *caminho) {
+    int fd = open(caminho, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        fprintf(stderr, "Erro ao abrir %s: %s\n", caminho, strerror(errno));
+        return -1;
+    }
+    struct termios t;
+    if (tcgetattr(fd, &t) == 0) {
+        cfmakeraw(&t);
+        tcsetattr(fd, TCSANOW, &t);
+    }
+    return fd;
+}
+
+static bool ler_quadro(FILE *f, uint8_t *quadro, size_t tamanho) {
+    return fread(quadro, 1, tamanho, f) == tamanho;
+}
+
+int main(int argc, char **argv) {
+    const char *porta = NULL;
+    const char *arquivo = "-";
+    uint pixels = 25;
+    uint fps = 60;
+    bool repetir = false;
+    int efeito = -1;
+    int sobreposicao = -1;
+    int brilho = -1;
+    const char *mensagem = NULL;
+    int velocidade = 0;
+    bool estatisticas = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+            porta = argv[++i];
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            pixels = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            fps = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-l")) {
+            repetir = true;
+        } else if (!strcmp(argv[i], "-e") && i + 1 < argc) {
+            efeito = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            sobreposicao = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-b") && i + 1 < argc) {
+            brilho = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            mensagem = argv[++i];
+        } else if (!strcmp(argv[i], "-v") && i + 1 < argc) {
+            velocidade = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-s")) {
+            estatisticas = true;
+        } else if (argv[i][0] != '-' || !strcmp(argv[i], "-")) {
+            arquivo = argv[i];
+        } else {
+            fprintf(stderr, "Uso: %s [-d porta] [-p pixels] [-f fps] [-l] [arquivo.grb | -]\n"
+                            "     %s [-d porta] -e efeito\n"
+                            "     %s [-d porta] -o efeito\n"
+                            "     %s [-d porta] -b brilho\n"
+                            "     %s [-d porta] [-v colunas/s] -t mensagem\n"
+                            "     %s -d porta -s\n", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (pixels == 0 || pixels * 4 > 0xFFFF) {
+        fprintf(stderr, "Número de pixels inválido\n");
+        return 2;
+    }
+
+    int fd = porta ? abrir_porta(porta) : STDOUT_FILENO;
+    if (fd < 0) {
+        return 1;
+    }
+
+    uint8_t cab[PROTOCOLO_CABECALHO];
+    if (estatisticas) {
+        if (!porta) {
+            fprintf(stderr, "-s precisa da porta (-d)\n");
+            return 2;
+        }
+        descartar_entrada(fd);
+        pacote_cabecalho(cab, PACOTE_ESTATISTICAS, 0, 0, 0, 0);
+        if (!escrever_tudo(fd, cab, sizeof(cab))) {
+            return 1;
+        }
+        mostrar_resposta(fd, 300);
+        return 0;
+    }
+    if (mensagem) {
+        size_t tamanho = strlen(mensagem);
+        if (tamanho == 0 || tamanho > TEXTO_MAX) {
+            fprintf(stderr, "A mensagem deve ter de 1 a %d caracteres\n", TEXTO_MAX);
+            return 2;
+        }
+        uint8_t conteudo[TEXTO_MAX + 1];
+        conteudo[0] = velocidade < 0 ? 0 : velocidade > 255 ? 255 : velocidade;
+        memcpy(&conteudo[1], mensagem, tamanho);
+        pacote_cabecalho(cab, PACOTE_TEXTO, 0, 0, tamanho + 1, 0);
+        return escrever_tudo(fd, cab, sizeof(cab)) && escrever_tudo(fd, conteudo, tamanho + 1) ? 0 : 1;
+    }
+    if (efeito >= 0 || sobreposicao >= 0 || brilho >= 0) {
+        uint32_t cmd = efeito >= 0 ? COMANDO(CMD_EFEITO, efeito) :
+                       sobreposicao >= 0 ? COMANDO(CMD_SOBREPOR, sobreposicao) :
+                       COMANDO(CMD_BRILHO, brilho > 255 ? 255 : brilho);
+        uint8_t conteudo[4];
+        pacote_cabecalho(cab, PACOTE_COMANDO, 0, 0, sizeof(conteudo), 0);
+        pacote_palavra(conteudo, cmd);
+        return escrever_tudo(fd, cab, sizeof(cab)) && escrever_tudo(fd, conteudo, sizeof(conteudo)) ? 0 : 1;
+    }
+
+    FILE *f = strcmp(arquivo, "-") ? fopen(arquivo, "rb") : stdin;
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir %s: %s\n", arquivo, strerror(errno));
+        return 1;
+    }
+
+    size_t tamanho = (size_t)pixels * 4;
+    uint8_t *quadro = malloc(tamanho);
+    uint64_t periodo_ns = fps ? 1000000000ull / fps : 0;
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    uint32_t enviados = 0;
+    while (true) {
+        if (!ler_quadro(f, quadro, tamanho)) {
+            if (repetir && f != stdin && enviados > 0) {
+                rewind(f);
+                continue;
+            }
+            break;
+        }
+
+        // Prazo absoluto de cada quadro: atrasos no envio não se acumulam
+        uint64_t prazo_ns = enviados * periodo_ns;
+        if (periodo_ns) {
+            uint64_t alvo = (uint64_t)inicio.tv_sec * 1000000000ull + inicio.tv_nsec + prazo_ns;
+            struct timespec ts = { .tv_sec = alvo / 1000000000ull, .tv_nsec = alvo % 1000000000ull };
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+            }
+        }
+
+        pacote_cabecalho(cab, PACOTE_QUADRO, periodo_ns ? PACOTE_USAR_PRAZO : 0, enviados,
+                         tamanho, (uint32_t)(prazo_ns / 1000));
+        if (!escrever_tudo(fd, cab, sizeof(cab)) || !escrever_tudo(fd, quadro, tamanho)) {
+            return 1;
+        }
+        if (porta) {
+            descartar_entrada(fd);
+        }
+        enviados++;
+    }
+
+    fprintf(stderr, "%u quadros enviados\n", enviados);
+    free(quadro);
+    return 0;
+}
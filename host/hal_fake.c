@@ -0,0 +1,664 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hal_fake.h"
+#include "hardware/dma.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "pico/bootrom.h"
+
+#define NUM_GPIOS 30
+#define NUM_CANAIS_DMA 12
+#define NUM_SLICES_PWM 8
+#define MAX_ALARMES 32
+#define INSTRUCOES_PIO 32
+#define NUM_IRQS 32
+
+pio_hw_t pio0_hw_fake, pio1_hw_fake;
+
+static uint64_t agora_us;
+static uint32_t frequencia_clk_sys = 125000000;
+static bool reset_usb_pedido;
+
+// ---------------------------------------------------------------------------
+// Saída gravada por state machine
+
+typedef struct {
+    uint32_t *dados;
+    size_t quantidade, capacidade;
+} Gravacao;
+
+static Gravacao saidas[2][4];
+
+static uint indice_pio(PIO pio) {
+    return pio == pio1 ? 1 : 0;
+}
+
+static void gravar_tx(PIO pio, uint sm, uint32_t palavra) {
+    Gravacao *g = &saidas[indice_pio(pio)][sm];
+    if (g->quantidade == g->capacidade) {
+        g->capacidade = g->capacidade ? g->capacidade * 2 : 1024;
+        g->dados = realloc(g->dados, g->capacidade * sizeof(uint32_t));
+        if (!g->dados) {
+            printf("Erro: sem memória para gravar a saída do PIO.\n");
+            abort();
+        }
+    }
+    g->dados[g->quantidade++] = palavra;
+    pio->txf[sm] = palavra;
+}
+
+const uint32_t *hal_fake_saida(PIO pio, uint sm, size_t *quantidade) {
+    Gravacao *g = &saidas[indice_pio(pio)][sm];
+    *quantidade = g->quantidade;
+    return g->dados;
+}
+
+void hal_fake_limpar_saida(void) {
+    for (int p = 0; p < 2; p++) {
+        for (int sm = 0; sm < 4; sm++) {
+            saidas[p][sm].quantidade = 0;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PIO
+
+static uint instrucoes_usadas[2];
+static uint32_t sms_usadas[2];
+
+int pio_add_program(PIO pio, const pio_program_t *program) {
+    uint *usadas = &instrucoes_usadas[indice_pio(pio)];
+    if (*usadas + program->length > INSTRUCOES_PIO) {
+        return -1;
+    }
+    int offset = (int)(INSTRUCOES_PIO - *usadas - program->length);
+    *usadas += program->length;
+    return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    uint32_t *usadas = &sms_usadas[indice_pio(pio)];
+    for (int sm = 0; sm < 4; sm++) {
+        if (!(*usadas & (1u << sm))) {
+            *usadas |= 1u << sm;
+            return sm;
+        }
+    }
+    if (required) {
+        printf("Erro: nenhuma state machine livre.\n");
+        abort();
+    }
+    return -1;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return indice_pio(pio) * 8 + sm + (is_tx ? 0 : 4);
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {}
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {}
+void pio_gpio_init(PIO pio, uint pin) {}
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {}
+
+// ---------------------------------------------------------------------------
+// Interrupções: um tratador por número, chamado na hora do evento
+
+static irq_handler_t tratadores[NUM_IRQS];
+static bool irqs_habilitadas[NUM_IRQS];
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    tratadores[num] = handler;
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority) {}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irqs_habilitadas[num] = enabled;
+}
+
+static void disparar_irq(uint num) {
+    if (irqs_habilitadas[num] && tratadores[num]) {
+        tratadores[num]();
+    }
+}
+
+// Flags de IRQ de cada bloco PIO e as fontes ligadas em cada linha
+static uint8_t flags_pio[2];
+static uint32_t fontes_pio[2][2];
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    uint32_t *fontes = &fontes_pio[indice_pio(pio)][0];
+    *fontes = enabled ? *fontes | (1u << source) : *fontes & ~(1u << source);
+}
+
+void pio_set_irq1_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    uint32_t *fontes = &fontes_pio[indice_pio(pio)][1];
+    *fontes = enabled ? *fontes | (1u << source) : *fontes & ~(1u << source);
+}
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num) {
+    return flags_pio[indice_pio(pio)] & (1u << pio_interrupt_num);
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num) {
+    flags_pio[indice_pio(pio)] &= ~(1u << pio_interrupt_num);
+}
+
+// O quadro enviado à state machine trava na hora: levanta a flag dela
+// (irq 0 rel) e chama a linha de IRQ em que essa flag estiver ligada
+static void fim_quadro(PIO pio, uint sm) {
+    uint p = indice_pio(pio);
+    flags_pio[p] |= 1u << sm;
+    for (uint linha = 0; linha < 2; linha++) {
+        if (fontes_pio[p][linha] & (1u << (pis_interrupt0 + sm))) {
+            disparar_irq(PIO0_IRQ_0 + 2 * p + linha);
+        }
+    }
+}
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data) {
+    gravar_tx(pio, sm, data);
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    gravar_tx(pio, sm, data);
+}
+
+// ---------------------------------------------------------------------------
+// DMA: cada disparo transfere tudo na hora
+
+typedef struct {
+    bool reservado;
+    dma_channel_config config;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint32_t contagem;
+    uint32_t disparos;
+} CanalDma;
+
+#define CTRL_TAMANHO_MASCARA 0x3u
+#define CTRL_INC_LEITURA (1u << 2)
+#define CTRL_INC_ESCRITA (1u << 3)
+
+static CanalDma canais[NUM_CANAIS_DMA];
+
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < NUM_CANAIS_DMA; i++) {
+        if (!canais[i].reservado) {
+            canais[i].reservado = true;
+            return i;
+        }
+    }
+    if (required) {
+        printf("Erro: nenhum canal DMA livre.\n");
+        abort();
+    }
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){ .ctrl = DMA_SIZE_32 | CTRL_INC_LEITURA };
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~CTRL_TAMANHO_MASCARA) | size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | CTRL_INC_LEITURA : c->ctrl & ~CTRL_INC_LEITURA;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | CTRL_INC_ESCRITA : c->ctrl & ~CTRL_INC_ESCRITA;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {}
+
+// Se o destino é a FIFO TX de uma state machine, devolve qual
+static bool destino_fifo(volatile void *escrita, PIO *pio, uint *sm) {
+    for (uint i = 0; i < 4; i++) {
+        if (escrita == &pio0->txf[i]) {
+            *pio = pio0;
+            *sm = i;
+            return true;
+        }
+        if (escrita == &pio1->txf[i]) {
+            *pio = pio1;
+            *sm = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void transferir(CanalDma *c) {
+    uint tamanho = 1u << (c->config.ctrl & CTRL_TAMANHO_MASCARA);
+    const volatile uint8_t *origem = c->leitura;
+    volatile uint8_t *destino = c->escrita;
+    PIO pio;
+    uint sm;
+    bool fifo = destino_fifo(c->escrita, &pio, &sm);
+
+    for (uint32_t i = 0; i < c->contagem; i++) {
+        uint32_t valor = 0;
+        memcpy(&valor, (const void *)origem, tamanho);
+        if (fifo) {
+            gravar_tx(pio, sm, valor);
+        } else {
+            memcpy((void *)destino, &valor, tamanho);
+        }
+        if (c->config.ctrl & CTRL_INC_LEITURA) {
+            origem += tamanho;
+        }
+        if (c->config.ctrl & CTRL_INC_ESCRITA) {
+            destino += tamanho;
+        }
+    }
+    c->disparos++;
+    if (fifo) {
+        fim_quadro(pio, sm);
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr, const volatile void *read_addr, uint transfer_count, bool trigger) {
+    CanalDma *c = &canais[channel];
+    c->config = *config;
+    c->escrita = write_addr;
+    c->leitura = read_addr;
+    c->contagem = transfer_count;
+    if (trigger) {
+        transferir(c);
+    }
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+    canais[channel].leitura = read_addr;
+    if (trigger) {
+        transferir(&canais[channel]);
+    }
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    canais[channel].contagem = trans_count;
+    if (trigger) {
+        transferir(&canais[channel]);
+    }
+}
+
+void dma_start_channel_mask(uint32_t chan_mask) {
+    for (uint i = 0; i < NUM_CANAIS_DMA; i++) {
+        if (chan_mask & (1u << i)) {
+            transferir(&canais[i]);
+        }
+    }
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return false;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {}
+
+uint32_t hal_fake_disparos_dma(uint canal) {
+    return canais[canal].disparos;
+}
+
+// ---------------------------------------------------------------------------
+// PWM
+
+typedef struct {
+    bool ligado;
+    uint32_t div16;
+    uint32_t wrap;
+    uint32_t nivel[2];
+} SlicePwm;
+
+static SlicePwm slices[NUM_SLICES_PWM];
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1) & 7;
+}
+
+uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1;
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    slices[slice_num].div16 = ((uint32_t)integer << 4) | (fract & 0xF);
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    slices[slice_num].wrap = wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    slices[slice_num].nivel[chan] = level;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    slices[slice_num].ligado = enabled;
+}
+
+uint hal_fake_pwm_frequencia(uint slice, uint canal) {
+    SlicePwm *s = &slices[slice];
+    if (!s->ligado || s->nivel[canal] == 0 || s->div16 == 0) {
+        return 0;
+    }
+    uint64_t periodo16 = (uint64_t)s->div16 * (s->wrap + 1);
+    return (uint)(((uint64_t)frequencia_clk_sys * 16 + periodo16 / 2) / periodo16);
+}
+
+// ---------------------------------------------------------------------------
+// Relógios
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return frequencia_clk_sys;
+}
+
+void hal_fake_clk_sys(uint32_t hz) {
+    frequencia_clk_sys = hz;
+}
+
+// ---------------------------------------------------------------------------
+// Alarmes em tempo virtual. Há um único relógio; os pools só servem para
+// o firmware cancelar seus próprios alarmes.
+
+struct alarm_pool {
+    int reservado;
+};
+
+typedef struct {
+    bool ativo;
+    alarm_id_t id;
+    alarm_pool_t *pool;
+    uint64_t alvo;
+    alarm_callback_t callback;
+    void *user_data;
+} Alarme;
+
+static alarm_pool_t pool_padrao, pools_extras[2];
+static uint num_pools_extras;
+static Alarme alarmes[MAX_ALARMES];
+static alarm_id_t proximo_id = 1;
+
+alarm_pool_t *alarm_pool_get_default(void) {
+    return &pool_padrao;
+}
+
+// O pool padrão usa o alarme 3, como no SDK; os outros, os alarmes livres
+uint alarm_pool_hardware_alarm_num(alarm_pool_t *pool) {
+    return pool == &pool_padrao ? 3 : (uint)(pool - pools_extras);
+}
+
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers) {
+    if (num_pools_extras == count_of(pools_extras)) {
+        return NULL;
+    }
+    return &pools_extras[num_pools_extras++];
+}
+
+alarm_id_t alarm_pool_add_alarm_at(alarm_pool_t *pool, absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    if (time <= agora_us && !fire_if_past) {
+        return 0;
+    }
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (!alarmes[i].ativo) {
+            // Um alarme já vencido dispara no próximo processamento, como a
+            // interrupção forçada do SDK, e não dentro desta chamada
+            alarmes[i] = (Alarme){
+                .ativo = true,
+                .id = proximo_id++,
+                .pool = pool,
+                .alvo = time < agora_us ? agora_us : time,
+                .callback = callback,
+                .user_data = user_data
+            };
+            return alarmes[i].id;
+        }
+    }
+    return -1;
+}
+
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return alarm_pool_add_alarm_at(pool, agora_us + us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t alarm_pool_add_alarm_in_ms(alarm_pool_t *pool, uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return alarm_pool_add_alarm_at(pool, agora_us + (uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool alarm_pool_cancel_alarm(alarm_pool_t *pool, alarm_id_t alarm_id) {
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].ativo && alarmes[i].id == alarm_id && alarmes[i].pool == pool) {
+            alarmes[i].ativo = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t alarme_repeticao(alarm_id_t id, void *user_data) {
+    repeating_timer_t *rt = user_data;
+    if (!rt->callback(rt)) {
+        return 0;
+    }
+    // Negativo: relativo ao disparo anterior; positivo: relativo a agora.
+    // Em tempo virtual as duas formas dão o mesmo resultado.
+    return rt->delay_us;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    if (delay_us == 0) {
+        delay_us = 1;
+    }
+    out->delay_us = delay_us;
+    out->pool = pool;
+    out->callback = callback;
+    out->user_data = user_data;
+    uint64_t atraso = delay_us < 0 ? (uint64_t)-delay_us : (uint64_t)delay_us;
+    out->alarm_id = alarm_pool_add_alarm_in_us(pool, atraso, alarme_repeticao, out, true);
+    return out->alarm_id > 0;
+}
+
+bool alarm_pool_add_repeating_timer_ms(alarm_pool_t *pool, int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    return alarm_pool_add_repeating_timer_us(pool, (int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    if (!timer->alarm_id) {
+        return false;
+    }
+    bool cancelado = alarm_pool_cancel_alarm(timer->pool, timer->alarm_id);
+    timer->alarm_id = 0;
+    return cancelado;
+}
+
+// Índice do alarme ativo de menor prazo (empate: o mais antigo), ou -1
+static int alarme_mais_cedo(void) {
+    int escolhido = -1;
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (!alarmes[i].ativo) {
+            continue;
+        }
+        if (escolhido < 0 || alarmes[i].alvo < alarmes[escolhido].alvo ||
+            (alarmes[i].alvo == alarmes[escolhido].alvo && alarmes[i].id < alarmes[escolhido].id)) {
+            escolhido = i;
+        }
+    }
+    return escolhido;
+}
+
+static void disparar(int i) {
+    Alarme *a = &alarmes[i];
+    if (a->alvo > agora_us) {
+        agora_us = a->alvo;
+    }
+    alarm_id_t id = a->id;
+    int64_t retorno = a->callback(id, a->user_data);
+
+    // O callback pode ter cancelado o próprio alarme, e a posição pode até
+    // ter sido reaproveitada por um alarme novo
+    if (!a->ativo || a->id != id) {
+        return;
+    }
+    if (retorno < 0) {
+        a->alvo += (uint64_t)-retorno;
+    } else if (retorno > 0) {
+        a->alvo = agora_us + (uint64_t)retorno;
+    } else {
+        a->ativo = false;
+    }
+}
+
+bool hal_fake_proximo_alarme(void) {
+    int i = alarme_mais_cedo();
+    if (i < 0) {
+        return false;
+    }
+    disparar(i);
+    return true;
+}
+
+void hal_fake_avancar_us(uint64_t us) {
+    uint64_t fim = agora_us + us;
+    int i;
+    while ((i = alarme_mais_cedo()) >= 0 && alarmes[i].alvo <= fim) {
+        disparar(i);
+    }
+    agora_us = fim;
+}
+
+uint64_t hal_fake_tempo_us(void) {
+    return agora_us;
+}
+
+uint64_t time_us_64(void) {
+    return agora_us;
+}
+
+void sleep_us(uint64_t us) {
+    hal_fake_avancar_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    hal_fake_avancar_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t t) {
+    if (t > agora_us) {
+        hal_fake_avancar_us(t - agora_us);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GPIO
+
+static bool gpio_saida[NUM_GPIOS];
+static bool gpio_entrada[NUM_GPIOS];
+static bool gpio_direcao[NUM_GPIOS];
+
+void gpio_init(uint gpio) {
+    gpio_direcao[gpio] = GPIO_IN;
+    gpio_saida[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    gpio_direcao[gpio] = out;
+}
+
+void gpio_put(uint gpio, bool value) {
+    gpio_saida[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return gpio_direcao[gpio] == GPIO_OUT ? gpio_saida[gpio] : gpio_entrada[gpio];
+}
+
+void gpio_pull_up(uint gpio) {
+    gpio_entrada[gpio] = true;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {}
+
+void hal_fake_gpio_entrada(uint gpio, bool valor) {
+    gpio_entrada[gpio] = valor;
+}
+
+bool hal_fake_gpio_saida(uint gpio) {
+    return gpio_saida[gpio];
+}
+
+// ---------------------------------------------------------------------------
+// stdio e bootrom
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+// Entrada da "USB": um descritor de arquivo (pipe, socket) ou nada. A espera
+// por dados é em tempo real; só um timeout avança o relógio virtual.
+static int fd_entrada = -1;
+
+void hal_fake_stdin(int fd) {
+    fd_entrada = fd;
+}
+
+static bool entrada_pronta(uint64_t timeout_us) {
+    if (fd_entrada < 0) {
+        return false;
+    }
+    struct pollfd p = { .fd = fd_entrada, .events = POLLIN };
+    return poll(&p, 1, (int)((timeout_us + 999) / 1000)) > 0;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    uint8_t c;
+    if (entrada_pronta(timeout_us) && read(fd_entrada, &c, 1) == 1) {
+        return c;
+    }
+    hal_fake_avancar_us(timeout_us);
+    return PICO_ERROR_TIMEOUT;
+}
+
+int stdio_get_until(char *buf, int len, absolute_time_t until) {
+    uint64_t timeout_us = until > agora_us ? until - agora_us : 0;
+    if (entrada_pronta(timeout_us)) {
+        ssize_t n = read(fd_entrada, buf, len);
+        if (n > 0) {
+            return (int)n;
+        }
+    }
+    sleep_until(until);
+    return PICO_ERROR_TIMEOUT;
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask) {
+    reset_usb_pedido = true;
+}
+
+bool hal_fake_reset_usb_pedido(void) {
+    return reset_usb_pedido;
+}
+
+// ---------------------------------------------------------------------------
+
+void hal_fake_reiniciar(void) {
+    agora_us = 0;
+    reset_usb_pedido = false;
+    memset(alarmes, 0, sizeof(alarmes));
+    hal_fake_limpar_saida();
+    for (int i = 0; i < NUM_CANAIS_DMA; i++) {
+        canais[i].disparos = 0;
+    }
+    memset(flags_pio, 0, sizeof(flags_pio));
+    memset(gpio_saida, 0, sizeof(gpio_saida));
+    memset(gpio_entrada, 0, sizeof(gpio_entrada));
+    memset(gpio_direcao, 0, sizeof(gpio_direcao));
+}
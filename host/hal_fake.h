@@ -0,0 +1,48 @@
+#ifndef HAL_FAKE_H
+#define HAL_FAKE_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Controle e inspeção do HAL falso usado no build do host.
+//
+// O tempo é virtual: só anda com sleep_*, hal_fake_avancar_us() e
+// hal_fake_proximo_alarme(), então os alarmes disparam exatamente no prazo
+// e a saída gravada é sempre a mesma, independente da máquina.
+
+// Volta o relógio a zero e apaga alarmes, saídas gravadas e estado de GPIO
+void hal_fake_reiniciar(void);
+
+uint64_t hal_fake_tempo_us(void);
+
+// Avança o relógio virtual, disparando os alarmes que vencerem no caminho
+void hal_fake_avancar_us(uint64_t us);
+
+// Avança o relógio até o próximo alarme e o dispara; false se não há alarmes
+bool hal_fake_proximo_alarme(void);
+
+// Palavras escritas na FIFO TX da state machine (put ou DMA), na ordem
+const uint32_t *hal_fake_saida(PIO pio, uint sm, size_t *quantidade);
+void hal_fake_limpar_saida(void);
+
+// Número de disparos de cada canal DMA desde hal_fake_reiniciar()
+uint32_t hal_fake_disparos_dma(uint canal);
+
+// Frequência em Hz que o canal PWM está gerando (0 se nível zero ou desligado)
+uint hal_fake_pwm_frequencia(uint slice, uint canal);
+
+// Nível lido por gpio_get() em um pino de entrada
+void hal_fake_gpio_entrada(uint gpio, bool valor);
+bool hal_fake_gpio_saida(uint gpio);
+
+// Descritor lido por getchar_timeout_us() e stdio_get_until(), no lugar da
+// USB; -1 (padrão) deixa a entrada sempre vazia
+void hal_fake_stdin(int fd);
+
+// Frequência devolvida por clock_get_hz(clk_sys), 125 MHz por padrão
+void hal_fake_clk_sys(uint32_t hz);
+
+// Indica se o firmware pediu para reiniciar em modo de gravação
+bool hal_fake_reset_usb_pedido(void);
+
+#endif
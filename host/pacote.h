@@ -0,0 +1,33 @@
+#ifndef PACOTE_H
+#define PACOTE_H
+
+// Montagem dos pacotes de protocolo.h no PC
+
+#include <stdint.h>
+
+#include "protocolo.h"
+
+static inline void pacote_cabecalho(uint8_t *cab, uint8_t tipo, uint8_t flags, uint16_t sequencia,
+                                    uint16_t tamanho, uint32_t prazo_us) {
+    cab[0] = PROTOCOLO_MARCA0;
+    cab[1] = PROTOCOLO_MARCA1;
+    cab[2] = tipo;
+    cab[3] = flags;
+    cab[4] = sequencia;
+    cab[5] = sequencia >> 8;
+    cab[6] = tamanho;
+    cab[7] = tamanho >> 8;
+    cab[8] = prazo_us;
+    cab[9] = prazo_us >> 8;
+    cab[10] = prazo_us >> 16;
+    cab[11] = prazo_us >> 24;
+}
+
+static inline void pacote_palavra(uint8_t *p, uint32_t valor) {
+    p[0] = valor;
+    p[1] = valor >> 8;
+    p[2] = valor >> 16;
+    p[3] = valor >> 24;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+// Interrupções falsas: o HAL guarda o tratador e o chama na hora em que o
+// evento acontece (por enquanto, só o fim de quadro dos blocos PIO)
+typedef void (*irq_handler_t)(void);
+
+#define TIMER_IRQ_0 0
+#define PIO0_IRQ_0 7
+#define PIO0_IRQ_1 8
+#define PIO1_IRQ_0 9
+#define PIO1_IRQ_1 10
+
+#define PICO_HIGHEST_IRQ_PRIORITY 0x00
+#define PICO_LOWEST_IRQ_PRIORITY 0xff
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_priority(uint num, uint8_t hardware_priority);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif
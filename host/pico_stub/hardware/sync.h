@@ -0,0 +1,12 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+static inline void __dmb(void) { __sync_synchronize(); }
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t estado) { (void)estado; }
+
+#endif
@@ -0,0 +1,580 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pio_emulador.h"
+
+// Codificação das instruções (datasheet do RP2040, 3.4): 3 bits de opcode,
+// 5 de delay/side-set e 8 de argumentos
+#define OP_JMP 0
+#define OP_OUT 3
+#define OP_PULL 4
+#define OP_MOV 5
+#define OP_IRQ 6
+#define OP_SET 7
+
+#define MAX_ROTULOS 32
+#define MAX_DEFINICOES 16
+#define MAX_LINHA 256
+#define MAX_TOKEN 64
+
+typedef struct {
+    char nome[32];
+    int endereco;
+} Rotulo;
+
+// Constante de .define, usada como valor de set/out/irq ou delay
+typedef struct {
+    char nome[32];
+    int valor;
+} Definicao;
+
+typedef struct {
+    Definicao itens[MAX_DEFINICOES];
+    int quantidade;
+} Definicoes;
+
+// Instrução montada pela metade: o destino do jmp só é resolvido no fim
+typedef struct {
+    uint16_t palavra;
+    char alvo[32];
+    int linha;
+} Pendente;
+
+static int indice_nome(const char *nome, const char *const *nomes, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        if (nomes[i] && !strcmp(nome, nomes[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Próximo token da linha: palavra, número ou um dos separadores , [ ] :
+static const char *token(const char **p, char *saida, size_t tamanho) {
+    while (isspace((unsigned char)**p)) {
+        (*p)++;
+    }
+    if (!**p) {
+        return NULL;
+    }
+    size_t n = 0;
+    if (strchr(",[]:", **p)) {
+        saida[n++] = *(*p)++;
+    } else {
+        while (**p && !isspace((unsigned char)**p) && !strchr(",[]:", **p) && n + 1 < tamanho) {
+            saida[n++] = *(*p)++;
+        }
+    }
+    saida[n] = '\0';
+    return saida;
+}
+
+static bool numero(const char *texto, int *valor) {
+    char *fim;
+    long v = strtol(texto, &fim, 0);
+    if (*texto == '\0' || *fim != '\0') {
+        return false;
+    }
+    *valor = (int)v;
+    return true;
+}
+
+// Número literal ou nome de um .define
+static bool valor_ou_nome(const char *texto, const Definicoes *defs, int *valor) {
+    if (numero(texto, valor)) {
+        return true;
+    }
+    for (int i = 0; defs && i < defs->quantidade; i++) {
+        if (!strcmp(defs->itens[i].nome, texto)) {
+            *valor = defs->itens[i].valor;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool erro(const char *caminho, int linha, const char *mensagem, const char *texto) {
+    fprintf(stderr, "%s:%d: %s '%s'\n", caminho, linha, mensagem, texto);
+    return false;
+}
+
+// Monta a instrução op com os argumentos em p; o destino de um jmp fica em
+// ins->alvo. Retorna NULL ou a mensagem de erro, com o texto culpado em arg.
+static const char *montar(const char *op, const char *p, const Definicoes *defs, Pendente *ins, char *arg) {
+    static const char *const destinos_out[8] = { "pins", "x", "y", "null", "pindirs", "pc", "isr", "exec" };
+    static const char *const destinos_set[8] = { "pins", "x", "y", NULL, "pindirs", NULL, NULL, NULL };
+    static const char *const destinos_mov[8] = { "pins", "x", "y", NULL, "exec", "pc", "isr", "osr" };
+    static const char *const origens_mov[8] = { "pins", "x", "y", "null", NULL, "status", "isr", "osr" };
+    static const char *const condicoes_jmp[8] = { NULL, "!x", "x--", "!y", "y--", "x!=y", "pin", "!osre" };
+
+    char tok[MAX_TOKEN];
+    int valor;
+    arg[0] = '\0';
+    if (!strcmp(op, "out") || !strcmp(op, "set")) {
+        bool out = op[0] == 'o';
+        int destino = token(&p, arg, MAX_TOKEN) ? indice_nome(arg, out ? destinos_out : destinos_set, 8) : -1;
+        if (destino < 0) {
+            return "destino inválido";
+        }
+        if (!token(&p, tok, sizeof(tok)) || strcmp(tok, ",") || !token(&p, arg, MAX_TOKEN) ||
+            !valor_ou_nome(arg, defs, &valor) || valor < (out ? 1 : 0) || valor > (out ? 32 : 31)) {
+            return "valor inválido";
+        }
+        ins->palavra = ((out ? OP_OUT : OP_SET) << 13) | (destino << 5) | (valor & 31);
+    } else if (!strcmp(op, "mov")) {
+        int destino = token(&p, arg, MAX_TOKEN) ? indice_nome(arg, destinos_mov, 8) : -1;
+        if (destino < 0) {
+            return "destino inválido";
+        }
+        if (!token(&p, tok, sizeof(tok)) || strcmp(tok, ",") || !token(&p, arg, MAX_TOKEN)) {
+            return "origem inválida";
+        }
+        // Operação colada na origem: ! ou ~ inverte, :: inverte a ordem dos bits
+        const char *origem = arg;
+        int operacao = 0;
+        if (arg[0] == '!' || arg[0] == '~') {
+            operacao = 1;
+            origem++;
+        } else if (!strncmp(arg, "::", 2)) {
+            operacao = 2;
+            origem += 2;
+        }
+        int indice = indice_nome(origem, origens_mov, 8);
+        if (indice < 0) {
+            return "origem inválida";
+        }
+        ins->palavra = (OP_MOV << 13) | (destino << 5) | (operacao << 3) | indice;
+    } else if (!strcmp(op, "irq")) {
+        // irq [set|nowait|wait|clear] n [rel]
+        bool limpar = false, esperar = false;
+        if (!token(&p, arg, MAX_TOKEN)) {
+            return "irq sem número";
+        }
+        if (!strcmp(arg, "set") || !strcmp(arg, "nowait") || !strcmp(arg, "wait") || !strcmp(arg, "clear")) {
+            limpar = !strcmp(arg, "clear");
+            esperar = !strcmp(arg, "wait");
+            if (!token(&p, arg, MAX_TOKEN)) {
+                return "irq sem número";
+            }
+        }
+        if (!valor_ou_nome(arg, defs, &valor) || valor < 0 || valor > 7) {
+            return "número de irq inválido";
+        }
+        const char *resto = p;
+        if (token(&resto, tok, sizeof(tok)) && !strcmp(tok, "rel")) {
+            valor |= 0x10;
+            p = resto;
+        }
+        ins->palavra = (OP_IRQ << 13) | (limpar << 6) | (esperar << 5) | valor;
+    } else if (!strcmp(op, "pull")) {
+        // pull [ifempty] [block|noblock]
+        bool se_vazia = false, bloquear = true;
+        const char *resto = p;
+        while (token(&resto, tok, sizeof(tok)) && strcmp(tok, "[")) {
+            if (!strcmp(tok, "ifempty")) {
+                se_vazia = true;
+            } else if (!strcmp(tok, "noblock")) {
+                bloquear = false;
+            } else if (strcmp(tok, "block")) {
+                snprintf(arg, MAX_TOKEN, "%s", tok);
+                return "opção de pull inválida";
+            }
+            p = resto;
+        }
+        ins->palavra = (OP_PULL << 13) | 0x80 | (se_vazia << 6) | (bloquear << 5);
+    } else if (!strcmp(op, "jmp")) {
+        if (!token(&p, arg, MAX_TOKEN)) {
+            return "jmp sem destino";
+        }
+        int condicao = indice_nome(arg, condicoes_jmp, 8);
+        if (condicao >= 0) {
+            if (!token(&p, arg, MAX_TOKEN)) {
+                return "jmp sem destino";
+            }
+        } else {
+            condicao = 0;
+        }
+        if (!strcmp(arg, ",")) {
+            token(&p, arg, MAX_TOKEN);
+        }
+        ins->palavra = (OP_JMP << 13) | (condicao << 5);
+        snprintf(ins->alvo, sizeof(ins->alvo), "%s", arg);
+    } else {
+        snprintf(arg, MAX_TOKEN, "%s", op);
+        return "instrução não suportada";
+    }
+
+    // Delay opcional: [n], até 31 sem side-set
+    if (token(&p, tok, sizeof(tok))) {
+        if (strcmp(tok, "[") || !token(&p, arg, MAX_TOKEN) || !valor_ou_nome(arg, defs, &valor) ||
+            valor < 0 || valor > 31 || !token(&p, tok, sizeof(tok)) || strcmp(tok, "]")) {
+            return "delay inválido";
+        }
+        ins->palavra |= valor << 8;
+    }
+    return NULL;
+}
+
+bool pio_montar(const char *caminho, ProgramaPio *programa) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir %s\n", caminho);
+        return false;
+    }
+
+    Rotulo rotulos[MAX_ROTULOS];
+    int num_rotulos = 0;
+    Definicoes defs = { .quantidade = 0 };
+    Pendente pendentes[PIO_MAX_INSTRUCOES];
+    memset(programa, 0, sizeof(*programa));
+    programa->wrap = -1;
+
+    char linha[MAX_LINHA], tok[MAX_TOKEN];
+    int num_linha = 0;
+    bool em_bloco = false, lido = false, ok = true;
+    while (ok && fgets(linha, sizeof(linha), f)) {
+        num_linha++;
+        // Comentários com ; ou //
+        char *c = strchr(linha, ';');
+        if (c) {
+            *c = '\0';
+        }
+        c = strstr(linha, "//");
+        if (c) {
+            *c = '\0';
+        }
+
+        const char *p = linha;
+        if (em_bloco) {
+            if (strstr(linha, "%}")) {
+                em_bloco = false;
+            }
+            continue;
+        }
+        if (!token(&p, tok, sizeof(tok))) {
+            continue;
+        }
+        if (tok[0] == '%') {
+            em_bloco = true;
+            continue;
+        }
+        if (!strcmp(tok, ".program")) {
+            if (lido) {
+                break;
+            }
+            lido = true;
+            continue;
+        }
+        if (!strcmp(tok, ".wrap_target")) {
+            programa->wrap_target = programa->tamanho;
+            continue;
+        }
+        if (!strcmp(tok, ".wrap")) {
+            programa->wrap = programa->tamanho - 1;
+            continue;
+        }
+        if (!strcmp(tok, ".define")) {
+            // .define [PUBLIC] nome valor
+            char nome[MAX_TOKEN] = "", texto[MAX_TOKEN];
+            if (token(&p, nome, sizeof(nome)) && !strcmp(nome, "PUBLIC")) {
+                token(&p, nome, sizeof(nome));
+            }
+            Definicao *d = &defs.itens[defs.quantidade];
+            if (defs.quantidade == MAX_DEFINICOES || !token(&p, texto, sizeof(texto)) ||
+                !valor_ou_nome(texto, &defs, &d->valor)) {
+                ok = erro(caminho, num_linha, ".define inválido", nome);
+                break;
+            }
+            snprintf(d->nome, sizeof(d->nome), "%s", nome);
+            defs.quantidade++;
+            continue;
+        }
+        if (tok[0] == '.') {
+            ok = erro(caminho, num_linha, "diretiva não suportada", tok);
+            break;
+        }
+
+        // Rótulo seguido ou não de instrução na mesma linha
+        const char *depois = p;
+        char separador[4];
+        if (token(&depois, separador, sizeof(separador)) && !strcmp(separador, ":")) {
+            if (num_rotulos == MAX_ROTULOS) {
+                ok = erro(caminho, num_linha, "rótulos demais em", tok);
+                break;
+            }
+            snprintf(rotulos[num_rotulos].nome, sizeof(rotulos[0].nome), "%s", tok);
+            rotulos[num_rotulos++].endereco = programa->tamanho;
+            p = depois;
+            if (!token(&p, tok, sizeof(tok))) {
+                continue;
+            }
+        }
+
+        if (programa->tamanho == PIO_MAX_INSTRUCOES) {
+            ok = erro(caminho, num_linha, "programa maior que", "32 instruções");
+            break;
+        }
+        Pendente *ins = &pendentes[programa->tamanho];
+        memset(ins, 0, sizeof(*ins));
+        ins->linha = num_linha;
+
+        char arg[MAX_TOKEN];
+        const char *mensagem = montar(tok, p, &defs, ins, arg);
+        if (mensagem) {
+            ok = erro(caminho, num_linha, mensagem, arg);
+            break;
+        }
+        programa->tamanho++;
+    }
+    fclose(f);
+    if (!ok) {
+        return false;
+    }
+    if (programa->tamanho == 0) {
+        fprintf(stderr, "%s: nenhuma instrução\n", caminho);
+        return false;
+    }
+    if (programa->wrap < 0) {
+        programa->wrap = programa->tamanho - 1;
+    }
+
+    // Resolve os destinos dos jmp, por rótulo ou endereço
+    for (int i = 0; i < programa->tamanho; i++) {
+        Pendente *ins = &pendentes[i];
+        if (ins->alvo[0]) {
+            int endereco = -1;
+            for (int r = 0; r < num_rotulos; r++) {
+                if (!strcmp(rotulos[r].nome, ins->alvo)) {
+                    endereco = rotulos[r].endereco;
+                }
+            }
+            if (endereco < 0 && (!numero(ins->alvo, &endereco) || endereco >= programa->tamanho)) {
+                return erro(caminho, ins->linha, "destino desconhecido", ins->alvo);
+            }
+            ins->palavra |= endereco;
+        }
+        programa->instrucoes[i] = ins->palavra;
+    }
+    return true;
+}
+
+bool pio_montar_instrucao(const char *texto, uint16_t *palavra) {
+    const char *p = texto;
+    char op[MAX_TOKEN], arg[MAX_TOKEN];
+    Pendente ins = { 0 };
+    if (!token(&p, op, sizeof(op))) {
+        return erro(texto, 0, "instrução vazia", texto);
+    }
+    const char *mensagem = montar(op, p, NULL, &ins, arg);
+    if (mensagem) {
+        return erro(texto, 0, mensagem, arg);
+    }
+    // Sem rótulos: o destino de um jmp é um endereço
+    int endereco = 0;
+    if (ins.alvo[0] && (!numero(ins.alvo, &endereco) || endereco < 0 || endereco >= PIO_MAX_INSTRUCOES)) {
+        return erro(texto, 0, "destino deve ser um endereço", ins.alvo);
+    }
+    *palavra = ins.palavra | endereco;
+    return true;
+}
+
+void pio_divisor(float div, uint16_t *div_int, uint8_t *div_frac) {
+    *div_int = (uint16_t)div;
+    *div_frac = *div_int ? (uint8_t)((div - *div_int) * 256.0f) : 0;
+}
+
+void pio_iniciar(MaquinaPio *sm, const ProgramaPio *programa, float div, int limiar_pull) {
+    memset(sm, 0, sizeof(*sm));
+    sm->programa = programa;
+    pio_divisor(div, &sm->div_int, &sm->div_frac);
+    sm->limiar_pull = limiar_pull;
+    sm->autopull = true;
+    sm->bits_osr = 32; // OSR vazia: o primeiro out já puxa da FIFO
+    sm->resto = 256;   // O primeiro ciclo da state machine é o primeiro do clk_sys
+}
+
+bool pio_colocar(MaquinaPio *sm, uint32_t palavra) {
+    if (sm->fifo_tamanho == PIO_FIFO_TX) {
+        return false;
+    }
+    sm->fifo[(sm->fifo_inicio + sm->fifo_tamanho) % PIO_FIFO_TX] = palavra;
+    sm->fifo_tamanho++;
+    return true;
+}
+
+static bool condicao_jmp(MaquinaPio *sm, int condicao) {
+    switch (condicao) {
+        case 0: return true;
+        case 1: return sm->x == 0;
+        case 2: return sm->x-- != 0;
+        case 3: return sm->y == 0;
+        case 4: return sm->y-- != 0;
+        case 5: return sm->x != sm->y;
+        case 6: return sm->pino;
+        default: return sm->bits_osr < sm->limiar_pull;
+    }
+}
+
+static uint32_t inverter_bits(uint32_t v) {
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) {
+        r = (r << 1) | ((v >> i) & 1);
+    }
+    return r;
+}
+
+// Retira a próxima palavra da FIFO para a OSR; false se estiver vazia
+static bool puxar(MaquinaPio *sm) {
+    if (sm->fifo_tamanho == 0) {
+        return false;
+    }
+    sm->osr = sm->fifo[sm->fifo_inicio];
+    sm->fifo_inicio = (sm->fifo_inicio + 1) % PIO_FIFO_TX;
+    sm->fifo_tamanho--;
+    sm->bits_osr = 0;
+    return true;
+}
+
+// Executa uma instrução; false se ela parou esperando a FIFO ou uma flag.
+// Do programa, o pc segue para a próxima (ou o wrap); de fora, como
+// pio_sm_exec(), o pc só muda se a instrução escrever nele e o delay é
+// ignorado.
+static bool executar(MaquinaPio *sm, uint16_t ins, bool do_programa) {
+    const ProgramaPio *prog = sm->programa;
+    int op = ins >> 13;
+    int atraso = do_programa ? (ins >> 8) & 31 : 0;
+    int destino = (ins >> 5) & 7;
+    int dado = ins & 31;
+    int proximo = !do_programa ? sm->pc : (sm->pc == prog->wrap) ? prog->wrap_target : sm->pc + 1;
+
+    switch (op) {
+        case OP_JMP:
+            if (condicao_jmp(sm, destino)) {
+                proximo = dado;
+            }
+            break;
+        case OP_OUT: {
+            // Autopull: com a OSR no limiar, recarrega da FIFO no mesmo ciclo
+            if (sm->autopull && sm->bits_osr >= sm->limiar_pull && !puxar(sm)) {
+                return false;
+            }
+            int bits = dado ? dado : 32;
+            // Deslocamento para a esquerda: os bits saem pelo MSB
+            uint32_t valor = bits == 32 ? sm->osr : sm->osr >> (32 - bits);
+            sm->osr = bits == 32 ? 0 : sm->osr << bits;
+            sm->bits_osr = sm->bits_osr + bits > 32 ? 32 : sm->bits_osr + bits;
+            switch (destino) {
+                case 0: sm->pino = valor & 1; break;
+                case 1: sm->x = valor; break;
+                case 2: sm->y = valor; break;
+                case 5: proximo = valor & 31; break;
+                case 6: sm->isr = valor; break;
+                default: break;
+            }
+            break;
+        }
+        case OP_PULL: {
+            bool se_vazia = ins & 0x40, bloquear = ins & 0x20;
+            if (se_vazia && sm->bits_osr < sm->limiar_pull) {
+                break;
+            }
+            if (!puxar(sm)) {
+                if (bloquear) {
+                    return false;
+                }
+                // Sem bloqueio e com a FIFO vazia, copia X para a OSR
+                sm->osr = sm->x;
+                sm->bits_osr = 0;
+            }
+            break;
+        }
+        case OP_MOV: {
+            uint32_t valor;
+            switch (ins & 7) {
+                case 0: valor = sm->pino; break;
+                case 1: valor = sm->x; break;
+                case 2: valor = sm->y; break;
+                case 6: valor = sm->isr; break;
+                case 7: valor = sm->osr; break;
+                default: valor = 0; break; // null, e status sem STATUS_SEL configurado
+            }
+            int operacao = (ins >> 3) & 3;
+            if (operacao == 1) {
+                valor = ~valor;
+            } else if (operacao == 2) {
+                valor = inverter_bits(valor);
+            }
+            switch (destino) {
+                case 0: sm->pino = valor & 1; break;
+                case 1: sm->x = valor; break;
+                case 2: sm->y = valor; break;
+                case 5: proximo = valor & 31; break;
+                case 6: sm->isr = valor; break;
+                case 7: sm->osr = valor; sm->bits_osr = 0; break;
+                default: abort(); // mov exec fica fora do subconjunto
+            }
+            break;
+        }
+        case OP_IRQ: {
+            // Com rel, os dois bits baixos do número somam o índice da state machine
+            int flag = (dado & 0x10) ? ((dado & 4) | ((dado + sm->indice) & 3)) : (dado & 7);
+            if (ins & 0x40) {
+                sm->irq &= ~(1u << flag);
+            } else if (ins & 0x20) {
+                // irq wait: levanta a flag uma vez e espera alguém limpar
+                if (!sm->esperando_irq) {
+                    sm->irq |= 1u << flag;
+                    sm->esperando_irq = true;
+                }
+                if (sm->irq & (1u << flag)) {
+                    return false;
+                }
+                sm->esperando_irq = false;
+            } else {
+                sm->irq |= 1u << flag;
+            }
+            break;
+        }
+        case OP_SET:
+            switch (destino) {
+                case 0: sm->pino = dado & 1; break;
+                case 1: sm->x = dado; break;
+                case 2: sm->y = dado; break;
+                default: break;
+            }
+            break;
+        default:
+            // Fora do subconjunto: pio_montar não gera outras instruções
+            abort();
+    }
+    sm->pc = proximo;
+    sm->atraso = atraso;
+    return true;
+}
+
+bool pio_executar(MaquinaPio *sm, uint16_t instrucao) {
+    return executar(sm, instrucao, false);
+}
+
+bool pio_ciclo(MaquinaPio *sm) {
+    sm->ciclos_sys++;
+
+    // Divisor fracionário: cada ciclo da state machine dura div_int ou
+    // div_int + 1 ciclos do clk_sys, com a fração acumulada em 8 bits.
+    // div_int 0 vale 65536.
+    sm->resto -= 256;
+    if (sm->resto > 0) {
+        return sm->pino;
+    }
+    sm->resto += 256 * (sm->div_int ? (int32_t)sm->div_int : 65536) + sm->div_frac;
+    sm->ciclos_pio++;
+
+    if (sm->atraso > 0) {
+        sm->atraso--;
+    } else if (!executar(sm, sm->programa->instrucoes[sm->pc], true)) {
+        sm->ciclos_parada++;
+    }
+    return sm->pino;
+}
@@ -0,0 +1,77 @@
+#ifndef PIO_EMULADOR_H
+#define PIO_EMULADOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Emulador de uma state machine PIO do RP2040, ciclo a ciclo do clk_sys,
+// para testar programas .pio no host. Cobre o subconjunto usado pelos
+// programas de saída da matriz: out, jmp (todas as condições), set, mov,
+// pull, irq, delays, .define, .wrap_target/.wrap, autopull e o divisor de
+// clock fracionário. Não há side-set, in/push nem wait.
+
+#define PIO_MAX_INSTRUCOES 32
+#define PIO_FIFO_TX 8 // FIFO TX com a RX unida a ela (PIO_FIFO_JOIN_TX)
+
+typedef struct {
+    uint16_t instrucoes[PIO_MAX_INSTRUCOES];
+    int tamanho;
+    int wrap_target, wrap;
+} ProgramaPio;
+
+typedef struct {
+    const ProgramaPio *programa;
+
+    // Configuração, como em sm_config_*
+    uint16_t div_int;
+    uint8_t div_frac;
+    int limiar_pull;       // Bits por palavra no autopull (1 a 32)
+    bool autopull;
+
+    int indice;            // Número da state machine, para irq rel
+
+    // Estado
+    int pc;
+    uint32_t x, y;
+    uint32_t osr, isr;
+    int bits_osr;          // Bits já deslocados para fora da OSR
+    int atraso;            // Ciclos de delay restantes da instrução anterior
+    bool pino;
+    uint32_t fifo[PIO_FIFO_TX];
+    int fifo_inicio, fifo_tamanho;
+    uint8_t irq;           // Flags de IRQ do bloco PIO (irq n levanta o bit n)
+    bool esperando_irq;    // Em um irq wait, esperando a flag ser limpa
+    int32_t resto;         // 1/256 de ciclo do clk_sys até o próximo ciclo da state machine
+
+    uint64_t ciclos_sys;   // clk_sys decorridos
+    uint64_t ciclos_pio;   // Ciclos em que a state machine avançou
+    uint64_t ciclos_parada; // Ciclos parada com a FIFO vazia ou em irq wait
+} MaquinaPio;
+
+// Monta um arquivo .pio com o subconjunto suportado. Só o primeiro .program
+// é lido e o bloco % c-sdk é ignorado. Em caso de erro escreve a linha em
+// stderr e retorna false.
+bool pio_montar(const char *caminho, ProgramaPio *programa);
+
+// Monta uma instrução avulsa (o destino de um jmp é um endereço), para
+// pio_executar()
+bool pio_montar_instrucao(const char *texto, uint16_t *palavra);
+
+// Calcula o divisor em 16.8 como sm_config_set_clkdiv(): parte inteira e
+// fração truncadas do valor em ponto flutuante
+void pio_divisor(float div, uint16_t *div_int, uint8_t *div_frac);
+
+// Prepara a state machine como pio_sm_init(): pc na origem, OSR vazia
+void pio_iniciar(MaquinaPio *sm, const ProgramaPio *programa, float div, int limiar_pull);
+
+// Coloca uma palavra na FIFO TX; false se estiver cheia
+bool pio_colocar(MaquinaPio *sm, uint32_t palavra);
+
+// Executa uma instrução fora do programa, como pio_sm_exec(); false se ela
+// parou (pull com a FIFO vazia, por exemplo)
+bool pio_executar(MaquinaPio *sm, uint16_t instrucao);
+
+// Avança um ciclo do clk_sys; retorna o nível do pino nesse ciclo
+bool pio_ciclo(MaquinaPio *sm);
+
+#endif
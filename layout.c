@@ -0,0 +1,54 @@
+#include "layout.h"
+
+const Layout layout_matriz = {
+    .painel_largura = MATRIZ_PAINEL_LARGURA,
+    .painel_altura = MATRIZ_PAINEL_ALTURA,
+    .paineis_x = MATRIZ_PAINEIS_X,
+    .paineis_y = MATRIZ_PAINEIS_Y,
+    .serpentina = MATRIZ_SERPENTINA,
+    .rotacao = MATRIZ_ROTACAO,
+    .espelhar_x = MATRIZ_ESPELHAR_X,
+    .espelhar_y = MATRIZ_ESPELHAR_Y
+};
+
+void layout_mapa(const Layout *layout, uint16_t *mapa) {
+    int largura_paineis = layout->painel_largura * layout->paineis_x;
+    int altura_paineis = layout->painel_altura * layout->paineis_y;
+    bool girada = layout->rotacao % 2;
+    int largura = girada ? altura_paineis : largura_paineis;
+    int altura = girada ? largura_paineis : altura_paineis;
+
+    for (int y = 0; y < altura; y++) {
+        for (int x = 0; x < largura; x++) {
+            // Posição nos painéis: a rotação 1 leva a linha de cima da
+            // imagem para a coluna da direita, de cima para baixo
+            int px, py;
+            switch (layout->rotacao % 4) {
+                case 1:  px = largura_paineis - 1 - y; py = x; break;
+                case 2:  px = largura_paineis - 1 - x; py = altura_paineis - 1 - y; break;
+                case 3:  px = y; py = altura_paineis - 1 - x; break;
+                default: px = x; py = y; break;
+            }
+            if (layout->espelhar_x) {
+                px = largura_paineis - 1 - px;
+            }
+            if (layout->espelhar_y) {
+                py = altura_paineis - 1 - py;
+            }
+
+            int painel = (py / layout->painel_altura) * layout->paineis_x + px / layout->painel_largura;
+            int linha = py % layout->painel_altura;
+            int coluna = px % layout->painel_largura;
+            if (layout->serpentina && (linha & 1)) {
+                coluna = layout->painel_largura - 1 - coluna;
+            }
+            mapa[y * largura + x] = painel * layout->painel_largura * layout->painel_altura +
+                                    linha * layout->painel_largura + coluna;
+        }
+    }
+
+    // A imagem ocupa os primeiros LEDs da cadeia; o resto fica no lugar
+    for (int i = largura * altura; i < NUM_PIXELS; i++) {
+        mapa[i] = i;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include "pico/stdlib.h"
+
+#include "matriz_led.h"
+
+// Disposição física dos LEDs. Todo o desenho é feito em coordenadas (x, y)
+// da imagem, linha a linha a partir do canto superior esquerdo (x cresce
+// para a direita e y para baixo); a ordem da cadeia de LEDs só aparece na
+// saída, quando o compositor empacota o quadro com a tabela de
+// layout_mapa(). Trocar a montagem da matriz é só trocar as opções abaixo,
+// que o CMake também pode definir.
+//
+// A matriz é feita de painéis iguais, encadeados linha a linha de painéis a
+// partir do canto superior esquerdo; dentro de cada painel a cadeia também
+// corre linha a linha, e em zigue-zague com MATRIZ_SERPENTINA. Antes disso a
+// imagem pode ser espelhada e girada. Com várias faixas (matriz_led.h), cada
+// faixa de PIXELS_POR_FAIXA LEDs recebe os painéis seguintes da cadeia.
+//
+// A placa 5x5 começa no canto inferior direito, com as linhas pares
+// (contadas de baixo) da direita para a esquerda: um painel em zigue-zague
+// espelhado nos dois eixos.
+
+// LEDs de um painel, na orientação em que a cadeia corre
+#ifndef MATRIZ_PAINEL_LARGURA
+#define MATRIZ_PAINEL_LARGURA 5
+#endif
+#ifndef MATRIZ_PAINEL_ALTURA
+#define MATRIZ_PAINEL_ALTURA 5
+#endif
+
+// Painéis lado a lado e um abaixo do outro
+#ifndef MATRIZ_PAINEIS_X
+#define MATRIZ_PAINEIS_X 1
+#endif
+#ifndef MATRIZ_PAINEIS_Y
+#define MATRIZ_PAINEIS_Y 1
+#endif
+
+#ifndef MATRIZ_SERPENTINA
+#define MATRIZ_SERPENTINA 1
+#endif
+
+// Quartos de volta, no sentido horário, da imagem em relação aos painéis
+#ifndef MATRIZ_ROTACAO
+#define MATRIZ_ROTACAO 0
+#endif
+
+#ifndef MATRIZ_ESPELHAR_X
+#define MATRIZ_ESPELHAR_X 1
+#endif
+#ifndef MATRIZ_ESPELHAR_Y
+#define MATRIZ_ESPELHAR_Y 1
+#endif
+
+// Dimensões da imagem, já com a rotação
+#define MATRIZ_LARGURA_PAINEIS (MATRIZ_PAINEL_LARGURA * MATRIZ_PAINEIS_X)
+#define MATRIZ_ALTURA_PAINEIS (MATRIZ_PAINEL_ALTURA * MATRIZ_PAINEIS_Y)
+#define MATRIZ_LARGURA ((MATRIZ_ROTACAO) % 2 ? MATRIZ_ALTURA_PAINEIS : MATRIZ_LARGURA_PAINEIS)
+#define MATRIZ_ALTURA ((MATRIZ_ROTACAO) % 2 ? MATRIZ_LARGURA_PAINEIS : MATRIZ_ALTURA_PAINEIS)
+
+#if MATRIZ_LARGURA_PAINEIS * MATRIZ_ALTURA_PAINEIS > NUM_PIXELS
+#error "A matriz não cabe no framebuffer"
+#endif
+
+typedef struct {
+    uint16_t painel_largura, painel_altura;
+    uint16_t paineis_x, paineis_y;
+    bool serpentina;
+    uint8_t rotacao;
+    bool espelhar_x, espelhar_y;
+} Layout;
+
+// Layout das opções de compilação
+extern const Layout layout_matriz;
+
+// Preenche mapa[NUM_PIXELS]: para cada pixel da imagem (y * largura + x),
+// o índice do LED na cadeia. Os pixels além da imagem vão, em ordem, para
+// os LEDs que sobram, então a tabela é uma permutação.
+void layout_mapa(const Layout *layout, uint16_t *mapa);
+
+#endif
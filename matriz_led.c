@@ -3,581 +3,164 @@
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 #include "pico/bootrom.h"
+#include "hardware/sync.h"
 
 // Arquivo .pio
 #include "matriz_led.pio.h"
 
-// Número de LEDs
-#define NUM_PIXELS 25
-
-// Pino de saída
-#define OUT_PIN 7
-
-// Teclado Matricial
-#define ROW1 10
-#define ROW2 9
-#define ROW3 8
-#define ROW4 6
-
-#define COL1 5
-#define COL2 4
-#define COL3 3
-#define COL4 2
-
-// Pino do buzzer
-#define BUZZER_PIN 21
-
-// Estrutura para armazenar dados de uma animação
-typedef struct {
-    double frames[25][NUM_PIXELS];
-    int num_frames;
-    double r, g, b;
-    int fps;
-} Animacao;
-
-// Função para configurar os GPIOs do teclado e LEDs
-void setup_gpio() {
-    int rows[] = {ROW1, ROW2, ROW3, ROW4};
-    int cols[] = {COL1, COL2, COL3, COL4};
-
-    // Configuração das linhas como saída
-    for (int i = 0; i < 4; i++) {
-        gpio_init(rows[i]);
-        gpio_set_dir(rows[i], GPIO_OUT);
-        gpio_put(rows[i], 1);
-    }
-
-    // Configuração das colunas como entrada com pull-up
-    for (int i = 0; i < 4; i++) {
-        gpio_init(cols[i]);
-        gpio_set_dir(cols[i], GPIO_IN);
-        gpio_pull_up(cols[i]);
-    }
-
-    // Configuração do buzzer
-    gpio_init(BUZZER_PIN);
-    gpio_set_dir(BUZZER_PIN, GPIO_OUT);
-    gpio_put(BUZZER_PIN, 0);
-}
-
-// Função para gerar tons no buzzer
-void buzzer_tone(uint frequency, uint duration_ms) {
-    uint32_t period_us = 1000000 / frequency; 
-    uint32_t half_period_us = period_us / 2;  
-    uint32_t cycles = (frequency * duration_ms) / 1000;
-
-    for (uint32_t i = 0; i < cycles; i++) {
-        gpio_put(BUZZER_PIN, 1);
-        sleep_us(half_period_us);
-        gpio_put(BUZZER_PIN, 0);
-        sleep_us(half_period_us);
-    }
-}
-
-// Função para detectar tecla pressionada
-char detect_key() {
-    const char keys[4][4] = {
-        {'1', '2', '3', 'A'},
-        {'4', '5', '6', 'B'},
-        {'7', '8', '9', 'C'},
-        {'*', '0', '#', 'D'}
-    };
-
-    int rows[4] = {ROW1, ROW2, ROW3, ROW4};
-    int cols[4] = {COL1, COL2, COL3, COL4};
-
-    for (int i = 0; i < 4; i++) {
-        gpio_put(rows[i], 0);
-        for (int j = 0; j < 4; j++) {
-            if (gpio_get(cols[j]) == 0) {
-                sleep_ms(200);
-                gpio_put(rows[i], 1);
-                return keys[i][j];
-            }
-        }
-        gpio_put(rows[i], 1);
-    }
-
-    return '\0';
-}
-
-// Função para criar cor RGB
-uint32_t matrix_rgb(double b, double r, double g) {
-    unsigned char R = r * 255;
-    unsigned char G = g * 255;
-    unsigned char B = b * 255;
-    return (G << 24) | (R << 16) | (B << 8);
-}
-
-// Inicializa o PIO para a matriz de LEDs
-void init_matriz_led(PIO pio, uint *offset, uint *sm) {
-    *offset = pio_add_program(pio, &matriz_led_program);
-    if (*offset < 0) {
+#include "matriz_led.h"
+#include "framebuffer.h"
+#include "animacoes.h"
+#include "comando.h"
+#include "protocolo.h"
+#include "registro.h"
+#include "reprodutor.h"
+#include "telemetria.h"
+#include "teclado.h"
+
+// Inicializa o PIO para a matriz de LEDs: uma state machine por faixa, todas
+// com o mesmo programa, cada uma no seu pino
+void init_matriz_led(PIO pio, uint *offset, uint sms[NUM_FAIXAS]) {
+    static const uint pinos[MAX_FAIXAS] = PINOS_FAIXAS;
+
+    int programa = pio_add_program(pio, &matriz_led_program);
+    if (programa < 0) {
         printf("Erro ao carregar programa PIO.\n");
         return;
     }
+    *offset = programa;
 
-    *sm = pio_claim_unused_sm(pio, true);
-    if (*sm < 0) {
-        printf("Erro ao requisitar state machine.\n");
-        return;
-    }
-
-    matriz_led_program_init(pio, *sm, *offset, OUT_PIN);
-}
-
-// Desenha um padrão na matriz de LEDs
-void desenho_pio(PIO pio, uint sm, double b, double r, double g) {
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        uint32_t valor_led = matrix_rgb(b, r, g);
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-}
-
-void executar_animacao(PIO pio, uint sm, Animacao *anim, int buzzer_freq, int buzzer_duration) {
-    int frame_delay = 1000 / anim->fps; // Calcula o tempo entre frames em milissegundos
-    for (int frame = 0; frame < anim->num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = anim->frames[frame][i];
-            uint32_t valor_led = matrix_rgb(anim->b * intensidade, anim->r * intensidade, anim->g * intensidade);
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
-        if (buzzer_freq > 0 && buzzer_duration > 0) {
-            buzzer_tone(buzzer_freq, buzzer_duration);
+    for (int k = 0; k < NUM_FAIXAS; k++) {
+        int sm = pio_claim_unused_sm(pio, true);
+        if (sm < 0) {
+            printf("Erro ao requisitar state machine.\n");
+            return;
         }
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
-    }
-}
+        sms[k] = sm;
 
-void executar_animacao_multicolor(PIO pio, uint sm, Animacao *anim, int buzzer_freq, int buzzer_duration, double r2, double g2, double b2) {
-    int frame_delay = 1000 / anim->fps; // Calcula o tempo entre frames em milissegundos
-    for (int frame = 0; frame < anim->num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = anim->frames[frame][i];
-            uint32_t valor_led;
-            if (i % 2 == 0) {
-                valor_led = matrix_rgb(anim->b * intensidade, anim->r * intensidade, anim->g * intensidade);
-            } else {
-                valor_led = matrix_rgb(b2 * intensidade, r2 * intensidade, g2 * intensidade);
-            }
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
-        if (buzzer_freq > 0 && buzzer_duration > 0) {
-            buzzer_tone(buzzer_freq, buzzer_duration);
-        }
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
+        matriz_led_program_init(pio, sms[k], *offset, pinos[k], PIXELS_POR_FAIXA);
     }
 }
 
-// Configuração de animações
-Animacao animacao_0 = {
-    .frames = {
-        {0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8},
-        {0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6},
-        {0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4},
-        {0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8},
-        {0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6},
-        {0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4},
-        {0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0}
-    },
-    .num_frames = 10,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 1.0,
-    .fps = 7
-};
-
-Animacao animacao_1 = {
-    .frames = {
-        {0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0},
-        {0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2},
-        {0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4},
-        {0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6},
-        {0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8},
-        {0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6},
-        {0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4},
-        {0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2},
-        {0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0},
-        {0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0},
-        {0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2},
-        {0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4},
-        {0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6},
-        {0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8, 1.0, 0.8},
-        {0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6, 0.8, 0.6},
-        {0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4, 0.6, 0.4},
-        {0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2, 0.4, 0.2},
-        {0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0, 0.2, 0.0}
-    },
-    .num_frames = 20,
-    .r = 1.0,
-    .g = 0.8,
-    .b = 0.0,
-    .fps = 5
-};
-
-Animacao animacao_2 = {
-    .frames = {
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2}
-    },
-    .num_frames = 10,
-    .r = 0.0,
-    .g = 0.0,
-    .b = 1.0,
-    .fps = 5
-};
-
-Animacao animacao_3_espiral_LUIZ = {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0},
-    },
-    .num_frames = 25,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 0.0,
-    .fps = 3
-};
-
-Animacao animacao_4 = {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0},
-        {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0},
-        {0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
-        {1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}
-    },
-    .num_frames = 9,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 1.0,
-    .fps = 3
-};
-
-Animacao animacao_5_lorenzo = {
-    .frames = {
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}, // L
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // O
-        {1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // R
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // E
-        {1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0}, // N
-        {1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // Z
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}  // O
-    },
-    .num_frames = 7,
-    .r = 0.0,
-    .g = 0.0,
-    .b = 0.0, // As cores serão tratadas dinamicamente por letra
-    .fps = 2
-};
-
-    const double lorenzo_colors[7][3] = {
-        {1.0, 0.0, 0.0}, // L - Vermelho
-        {0.0, 1.0, 0.0}, // O - Verde
-        {0.0, 0.0, 1.0}, // R - Azul
-        {1.0, 1.0, 0.0}, // E - Amarelo
-        {1.0, 0.0, 1.0}, // N - Magenta
-        {0.0, 1.0, 1.0}, // Z - Ciano
-        {1.0, 0.5, 0.0}  // O - Laranja
-    };
-
-    void executar_animacao_lorenzo(PIO pio, uint sm) {
-    for (int frame = 0; frame < animacao_5_lorenzo.num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = animacao_5_lorenzo.frames[frame][i];
-            uint32_t valor_led = matrix_rgb(lorenzo_colors[frame][2] * intensidade, lorenzo_colors[frame][0] * intensidade, lorenzo_colors[frame][1] * intensidade);
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
-        buzzer_tone(440 + (frame * 50), 200);
-        sleep_ms(1000 / animacao_5_lorenzo.fps); // Calcula o tempo entre frames com base no FPS
+// Dorme até a próxima interrupção: eventos do teclado (IRQ do PIO que faz a
+// varredura), dados da USB e alarmes dos quadros e do buzzer. As interrupções
+// ficam mascaradas da verificação até o __wfi, então uma que chegue nesse
+// meio-tempo fica pendente e acorda o núcleo na hora, em vez de se perder.
+// O registro pendente não impede o sono: se o PC não lê, nada sai até ele
+// voltar, e a tarefa da USB a cada 1 ms já acorda o laço para drenar.
+static void aguardar_interrupcao(void) {
+    uint32_t estado = save_and_disable_interrupts();
+    if (!teclado_pendente()) {
+        uint32_t inicio_us = time_us_32();
+        __wfi();
+        telemetria_ocioso(inicio_us);
     }
+    restore_interrupts(estado);
 }
 
-Animacao animacao_6_musica = {
-	.frames = {
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //sol
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0} //fa
-	},
-	.num_frames = 24,
-	.r = 0.0,
-	.g = 0.0,
-	.b = 0.0,
-	.fps = 4
-	
-};
-
-	const double musica_colors[24][3] = { // degradê de azul, onde o dó é o azul mais forte e o sol é o mais claro
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.2}, //sol
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-	};
-
-	void executar_animacao_musica(PIO pio, uint sm) {
-		for (int frame = 0; frame < animacao_6_musica.num_frames; frame++) {
-        		for (int i = 0; i < NUM_PIXELS; i++) {
-           			double intensidade = animacao_6_musica.frames[frame][i];
-            			uint32_t valor_led = matrix_rgb(musica_colors[frame][2] * intensidade, musica_colors[frame][0] * intensidade, musica_colors[frame][1] * intensidade);
-            			pio_sm_put_blocking(pio, sm, valor_led);
-        	    }
-        	if (frame == 0 || frame == 6 || frame == 8 || frame == 12 || frame == 18){
-			    buzzer_tone(261, 250);
-			    sleep_ms(1000 / animacao_6_musica.fps);	
-			} else if (frame == 1 || frame == 7 || frame == 9 || frame == 10 || frame == 11 || frame == 19){
-			    buzzer_tone(293, 250);
-			    sleep_ms(1000 / animacao_6_musica.fps);
-			} else if (frame == 2 || frame == 15 || frame == 16 || frame == 17 || frame == 20){
-				buzzer_tone(329, 250);
-				sleep_ms(1000 / animacao_6_musica.fps);
-			} else if (frame == 3 || frame == 4 || frame == 5 || frame == 14 || frame == 21 || frame == 22 || frame == 23){
-				buzzer_tone(349, 250);
-				sleep_ms(1000 / animacao_6_musica.fps);
-			} else {
-				buzzer_tone (392, 250);
-				sleep_ms(1000 / animacao_6_musica.fps); 
-			}
-
-        }    
-    }
-
-// Função para simular a sirene de polícia
-Animacao animacao_7_sirene = {
-    .frames = {
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0},  // Azul
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0},  // Azul
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0}  // Azul
-    },
-    .num_frames = 6,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 0.0,
-    .fps = 3 
-};
-
-void executar_animacao_sirene(PIO pio, uint sm) {
-    int frame_delay = 1000 / animacao_7_sirene.fps; 
-    int repeat_count = 3 * animacao_7_sirene.fps; // Número de repetições para 3 segundos
-
-    // Executa a animação e o som de forma sincronizada
-    for (int repeat = 0; repeat < repeat_count; repeat++) {
-        int frame = repeat % animacao_7_sirene.num_frames; // Calcula o frame atual
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = animacao_7_sirene.frames[frame][i]; // Intensidade do LED
-            double r = (frame % 2 == 0) ? 1.0 : 0.0; // Alterna entre vermelho e azul
-            double g = 0.0;
-            double b = (frame % 2 == 0) ? 0.0 : 1.0;
-            uint32_t valor_led = matrix_rgb(b * intensidade, r * intensidade, g * intensidade); // Cria a cor RGB
-            pio_sm_put_blocking(pio, sm, valor_led); // Envia o valor para o PIO
-        }
-        buzzer_tone(1000 - (frame % 2) * 300, frame_delay); // Alterna entre 1000 Hz e 700 Hz
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
-    }
-}
-
-Animacao animacao_8_countdown = {
-    .frames = {
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.8, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.8},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8}
-    },
-    .num_frames = 6,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 0.0,
-    .fps = 1
-};
-
-Animacao animacao_9_Felipe = {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}
-    },
-    .num_frames = 10,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 1.0,
-    .fps = 5
-};
-
+// A mensagem vai para o registro e sai pela USB quando o laço tiver tempo
 void exibir_mensagem(const char *mensagem) {
-    printf("\n\n========== %s ==========\n", mensagem);
+    registro("\n\n========== %s ==========\n", mensagem);
 }
 
 int main() {
     PIO pio = pio0;
-    uint offset, sm;
+    uint offset, sms[NUM_FAIXAS];
 
     // Configurações iniciais
     stdio_init_all();
-    setup_gpio();
-    init_matriz_led(pio, &offset, &sm);
+    init_matriz_led(pio, &offset, sms);
+    framebuffer_init(pio, sms);
+    comando_init();
+    teclado_init(pio1);
 
     while (true) {
+        // Quadros e comandos enviados pelo PC (host/enviar_quadros)
+        bool recebeu_quadro = protocolo_processar();
+        registro_drenar();
+
         char key = detect_key();
         if (key != '\0') {
+            telemetria_marcar_tecla();
             switch (key) {
                 case '0':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_GRADIENTE));
                     exibir_mensagem("0 - GRADIENTE ROSA");
-                    executar_animacao(pio, sm, &animacao_0, 0, 0);
                     break;
                 case '1':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_FADE));
                     exibir_mensagem("1 - ANIMAÇÃO DE FADE 0 > 1 > 0 > 1 > 0");
-                    executar_animacao(pio, sm, &animacao_1, 0, 0);
                     break;
                 case '2':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_PISCA));
                     exibir_mensagem("2 - PISCA PISCA COM BUZZER");
-                    executar_animacao(pio, sm, &animacao_2, 800, 200);
                     break;
                 case '3':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_ESPIRAL));
                     exibir_mensagem("3 - ESPIRAL COM BUZZER");
-                    executar_animacao(pio, sm, &animacao_3_espiral_LUIZ, 800, 200);
                     break;
                 case '4':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_BARRAS));
                     exibir_mensagem("4 - ANIMAÇÃO DE BARRAS");
-                    executar_animacao(pio, sm, &animacao_4, 500, 100);
                     break;
                 case '5':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_LORENZO));
                     exibir_mensagem("5 - ESCREVER O NOME L O R E N Z O");
-                    executar_animacao_lorenzo(pio, sm);
                     break;
                 case '6':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_MUSICA));
                     exibir_mensagem("6 - MUSICA DÓ, RÉ, MI, FÁ");
-                    executar_animacao_musica(pio, sm);
                     break;
                 case '7':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_SIRENE));
                     exibir_mensagem("7 - SIRENE DE POLÍCIA");
-                    executar_animacao_sirene(pio, sm);
                     break;
                 case '8':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_CONTAGEM));
                     exibir_mensagem("8 - CONTAGEM REGRESSIVA 5, 4, 3, 2, 1");
-                    executar_animacao(pio, sm, &animacao_8_countdown, 200, 500);
                     break;
                 case '9':
+                    comando_enviar(COMANDO(CMD_EFEITO, EFEITO_PERSONALIZADO));
                     exibir_mensagem("9 - PISCA PISCA PERSONALIZADO");
-                    executar_animacao(pio, sm, &animacao_9_Felipe, 600, 80);
                     break;
                 case 'A':
+                    comando_enviar(COMANDO(CMD_PREENCHER, matrix_rgb(0, 0, 0) >> 8));
                     exibir_mensagem("LEDs DESLIGADOS");
-                    desenho_pio(pio, sm, 0.0, 0.0, 0.0);
                     break;
                 case 'B':
+                    comando_enviar(COMANDO(CMD_PREENCHER, matrix_rgb(255, 0, 0) >> 8));
                     exibir_mensagem("TODOS OS LEDs EM AZUL 100%");
-                    desenho_pio(pio, sm, 1.0, 0.0, 0.0);
                     break;
                 case 'C':
+                    comando_enviar(COMANDO(CMD_PREENCHER, matrix_rgb(0, INTENSIDADE(0.8), 0) >> 8));
                     exibir_mensagem("TODOS OS LEDs EM VERMELHO 80%");
-                    desenho_pio(pio, sm, 0.0, 0.8, 0.0);
                     break;
                 case 'D':
+                    comando_enviar(COMANDO(CMD_PREENCHER, matrix_rgb(0, 0, INTENSIDADE(0.5)) >> 8));
                     exibir_mensagem("TODOS OS LEDs EM VERDE 50%");
-                    desenho_pio(pio, sm, 0.0, 0.0, 0.5);
                     break;
                 case '#':
+                    comando_enviar(COMANDO(CMD_PREENCHER, matrix_rgb(INTENSIDADE(0.2), INTENSIDADE(0.2), INTENSIDADE(0.2)) >> 8));
                     exibir_mensagem("TODOS OS LEDs EM BRANCO 20%");
-                    desenho_pio(pio, sm, 0.2, 0.2, 0.2);
                     break;
                 case '*':
+                    comando_enviar(COMANDO(CMD_PARAR, 0));
                     exibir_mensagem("HABILITANDO O MODO GRAVAÇÃO");
+                    // O laço não volta mais: esvazia o registro aqui, com um
+                    // limite caso o PC não esteja lendo
+                    absolute_time_t limite = make_timeout_time_ms(500);
+                    while (registro_pendente() && !time_reached(limite)) {
+                        registro_drenar();
+                    }
+                    stdio_flush();
                     sleep_ms (500);
                     reset_usb_boot(0, 0);
                     break;
                 default:
                     break;
             }
+        } else if (!recebeu_quadro) {
+            aguardar_interrupcao();
         }
     }
 
@@ -0,0 +1,55 @@
+#ifndef MATRIZ_LED_H
+#define MATRIZ_LED_H
+
+// Saída em faixas paralelas: cada faixa é uma cadeia de LEDs em um pino
+// próprio, transmitida por uma state machine do pio0 ao mesmo tempo que as
+// outras. O tempo de atualização depende só de PIXELS_POR_FAIXA (cerca de
+// 30 µs por LED), então instalações grandes devem ser divididas em faixas.
+// Os valores podem ser trocados pelo CMake (MATRIZ_NUM_FAIXAS e
+// MATRIZ_PIXELS_POR_FAIXA).
+#ifndef NUM_FAIXAS
+#define NUM_FAIXAS 1
+#endif
+
+#ifndef PIXELS_POR_FAIXA
+#define PIXELS_POR_FAIXA 25
+#endif
+
+// O pio1 está ocupado pelo teclado, então o limite é o número de state
+// machines do pio0
+#define MAX_FAIXAS 4
+
+#if NUM_FAIXAS < 1 || NUM_FAIXAS > MAX_FAIXAS
+#error "NUM_FAIXAS deve estar entre 1 e MAX_FAIXAS"
+#endif
+
+// Número de LEDs: um único framebuffer, dividido entre as faixas em ordem
+// (a faixa k recebe os pixels k * PIXELS_POR_FAIXA em diante)
+#define NUM_PIXELS (NUM_FAIXAS * PIXELS_POR_FAIXA)
+
+// As animações são desenhadas para a matriz 5x5 nos primeiros 25 LEDs
+#if NUM_PIXELS < 25
+#error "São necessários pelo menos 25 LEDs para a matriz 5x5"
+#endif
+
+// Pino de saída da primeira faixa (matriz 5x5)
+#define OUT_PIN 7
+
+// Pinos de saída de cada faixa, na ordem
+#define PINOS_FAIXAS {OUT_PIN, 16, 17, 18}
+
+// Teclado Matricial
+#define ROW1 10
+#define ROW2 9
+#define ROW3 8
+#define ROW4 6
+
+#define COL1 5
+#define COL2 4
+#define COL3 3
+#define COL4 2
+
+// Pino do buzzer
+#define BUZZER_PIN 21
+
+#endif
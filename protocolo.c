@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "protocolo.h"
+#include "agendador.h"
+#include "comando.h"
+#include "framebuffer.h"
+#include "reprodutor.h"
+#include "telemetria.h"
+#include "hardware/sync.h"
+
+// Tempo máximo para receber o conteúdo de um pacote depois do cabeçalho
+#define TIMEOUT_CONTEUDO_US 100000
+
+// Atraso ou adiantamento acima disso realinha o relógio do fluxo (o PC
+// recomeçou o envio ou ficou parado)
+#define REALINHAR_US 200000
+
+// Os quadros chegam em dois buffers alternados, lidos direto pelo DMA.
+// Um buffer só volta a ser escrito depois que o render apresentou o
+// seguinte, ou seja, depois que o DMA terminou de lê-lo.
+static uint32_t buffers_quadro[2][NUM_PIXELS];
+static absolute_time_t prazos[2];
+static bool com_prazo[2];
+static volatile bool ocupado[2];
+static volatile alarm_id_t alarmes_quadro[2]; // Apresentação agendada de cada buffer
+static uint proximo_buffer = 0;
+
+_Static_assert(sizeof(buffers_quadro[0]) <= 0xFFFF, "Quadro grande demais para o campo de tamanho do pacote");
+
+// Mensagem recebida, com a velocidade no primeiro byte. O render copia a
+// mensagem ao executar CMD_TEXTO e libera o buffer para a seguinte.
+static char buffer_texto[TEXTO_MAX + 2];
+static volatile bool texto_pendente = false;
+
+// Estado da leitura (núcleo da USB)
+static uint8_t cabecalho[PROTOCOLO_CABECALHO];
+static uint bytes_cabecalho = 0;
+static bool relogio_alinhado = false;
+static int64_t inicio_fluxo_us; // Instante local correspondente ao prazo 0
+
+// Estado da apresentação (núcleo de render)
+static alarm_pool_t *pool_protocolo;
+static int ultimo_apresentado = -1;
+
+static EstatisticasProtocolo estatisticas;
+
+void protocolo_init(alarm_pool_t *pool) {
+    pool_protocolo = pool;
+}
+
+static uint16_t ler16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t ler32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Lê exatamente tamanho bytes; false se o PC parar de enviar no meio
+static bool ler_conteudo(void *destino, uint tamanho) {
+    absolute_time_t limite = make_timeout_time_us(TIMEOUT_CONTEUDO_US);
+    uint lidos = 0;
+    while (lidos < tamanho) {
+        int n = stdio_get_until((char *)destino + lidos, tamanho - lidos, limite);
+        if (n <= 0) {
+            return false;
+        }
+        lidos += n;
+    }
+    estatisticas.bytes += tamanho + PROTOCOLO_CABECALHO;
+    return true;
+}
+
+// Descarta o conteúdo de um pacote inválido para não perder o sincronismo
+static void descartar_conteudo(uint tamanho) {
+    uint8_t lixo[64];
+    while (tamanho > 0) {
+        uint n = tamanho < sizeof(lixo) ? tamanho : sizeof(lixo);
+        if (!ler_conteudo(lixo, n)) {
+            break;
+        }
+        tamanho -= n;
+    }
+    estatisticas.descartados++;
+}
+
+// Converte o prazo do PC para o relógio local. O primeiro quadro com prazo
+// define a origem; depois só se realinha quando a diferença fica grande.
+static absolute_time_t prazo_local(uint32_t prazo_us) {
+    int64_t agora = to_us_since_boot(get_absolute_time());
+    int64_t local = inicio_fluxo_us + prazo_us;
+    if (!relogio_alinhado || local < agora - REALINHAR_US || local > agora + REALINHAR_US) {
+        inicio_fluxo_us = agora - prazo_us;
+        relogio_alinhado = true;
+        local = agora;
+    }
+    return from_us_since_boot(local);
+}
+
+static bool receber_quadro(uint8_t flags, uint tamanho, uint32_t prazo_us) {
+    if (tamanho != sizeof(buffers_quadro[0])) {
+        descartar_conteudo(tamanho);
+        return false;
+    }
+
+    // Espera o render liberar o buffer; isso também segura o PC, que fica
+    // bloqueado na USB enquanto estiver adiantado
+    uint indice = proximo_buffer;
+    while (ocupado[indice]) {
+        // Um quadro cancelado antes do prazo libera o buffer dele fora da vez
+        if (!ocupado[indice ^ 1]) {
+            indice ^= 1;
+            break;
+        }
+        tight_loop_contents();
+    }
+
+    // Única cópia: do buffer da USB para o buffer que o DMA vai ler
+    if (!ler_conteudo(buffers_quadro[indice], tamanho)) {
+        estatisticas.descartados++;
+        return false;
+    }
+
+    com_prazo[indice] = flags & PACOTE_USAR_PRAZO;
+    if (com_prazo[indice]) {
+        prazos[indice] = prazo_local(prazo_us);
+    }
+    ocupado[indice] = true;
+    __dmb();
+    proximo_buffer = indice ^ 1;
+    estatisticas.quadros++;
+    comando_enviar(COMANDO(CMD_QUADRO, indice));
+    return true;
+}
+
+static void receber_texto(uint tamanho) {
+    if (tamanho < 2 || tamanho > TEXTO_MAX + 1) {
+        descartar_conteudo(tamanho);
+        return;
+    }
+    while (texto_pendente) {
+        tight_loop_contents();
+    }
+    if (!ler_conteudo(buffer_texto, tamanho)) {
+        estatisticas.descartados++;
+        return;
+    }
+    buffer_texto[tamanho] = '\0';
+    texto_pendente = true;
+    __dmb();
+    comando_enviar(COMANDO(CMD_TEXTO, 0));
+}
+
+// Comandos que o PC pode enviar direto. CMD_QUADRO e CMD_TEXTO apontam
+// para buffers deste arquivo e só saem daqui, depois que o conteúdo chegou.
+static bool comando_publico(uint32_t cmd) {
+    switch (COMANDO_TIPO(cmd)) {
+        case CMD_PARAR:
+        case CMD_EFEITO:
+        case CMD_PREENCHER:
+        case CMD_BRILHO:
+        case CMD_SOBREPOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool protocolo_processar(void) {
+    // Cabeçalho byte a byte, sem bloquear, procurando o marcador de início
+    while (bytes_cabecalho < PROTOCOLO_CABECALHO) {
+        int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) {
+            return false;
+        }
+        if ((bytes_cabecalho == 0 && c != PROTOCOLO_MARCA0) ||
+            (bytes_cabecalho == 1 && c != PROTOCOLO_MARCA1)) {
+            bytes_cabecalho = (c == PROTOCOLO_MARCA0) ? 1 : 0;
+            cabecalho[0] = c;
+            continue;
+        }
+        cabecalho[bytes_cabecalho++] = c;
+    }
+    bytes_cabecalho = 0;
+
+    uint8_t tipo = cabecalho[2];
+    uint8_t flags = cabecalho[3];
+    uint tamanho = ler16(&cabecalho[6]);
+    uint32_t prazo_us = ler32(&cabecalho[8]);
+
+    switch (tipo) {
+        case PACOTE_QUADRO:
+            return receber_quadro(flags, tamanho, prazo_us);
+        case PACOTE_COMANDO: {
+            uint8_t conteudo[4];
+            if (tamanho != sizeof(conteudo)) {
+                descartar_conteudo(tamanho);
+            } else if (ler_conteudo(conteudo, sizeof(conteudo))) {
+                uint32_t cmd = ler32(conteudo);
+                if (comando_publico(cmd)) {
+                    comando_enviar(cmd);
+                } else {
+                    estatisticas.descartados++;
+                }
+            } else {
+                estatisticas.descartados++;
+            }
+            return false;
+        }
+        case PACOTE_ESTATISTICAS:
+            if (tamanho != 0) {
+                descartar_conteudo(tamanho);
+            } else {
+                telemetria_relatorio();
+            }
+            return false;
+        case PACOTE_TEXTO:
+            receber_texto(tamanho);
+            return false;
+        default:
+            descartar_conteudo(tamanho);
+            return false;
+    }
+}
+
+static void apresentar(uint indice) {
+    framebuffer_apresentar_quadro(buffers_quadro[indice]);
+
+    // O DMA terminou o quadro anterior antes de começar este, então o
+    // buffer dele pode voltar a receber dados
+    if (ultimo_apresentado >= 0 && ultimo_apresentado != (int)indice) {
+        ocupado[ultimo_apresentado] = false;
+    }
+    ultimo_apresentado = indice;
+}
+
+static int64_t alarme_quadro(alarm_id_t id, void *user_data) {
+    uint indice = (uint)(uintptr_t)user_data;
+    alarmes_quadro[indice] = 0;
+    apresentar(indice);
+    return 0;
+}
+
+void protocolo_executar_quadro(uint indice) {
+    if (indice >= count_of(buffers_quadro)) {
+        return;
+    }
+    // Quadros ao vivo substituem a animação em andamento
+    if (agendador_ativo()) {
+        agendador_parar();
+    }
+
+    if (!com_prazo[indice]) {
+        apresentar(indice);
+        return;
+    }
+
+    int64_t espera = absolute_time_diff_us(get_absolute_time(), prazos[indice]);
+    if (espera <= 0) {
+        if (espera < 0) {
+            estatisticas.atrasados++;
+        }
+        apresentar(indice);
+        return;
+    }
+    alarm_id_t id = alarm_pool_add_alarm_at(pool_protocolo, prazos[indice], alarme_quadro, (void *)(uintptr_t)indice, true);
+    if (id > 0) {
+        alarmes_quadro[indice] = id;
+    } else if (id < 0) {
+        apresentar(indice);
+    }
+}
+
+void protocolo_cancelar_quadros(void) {
+    for (uint i = 0; i < count_of(alarmes_quadro); i++) {
+        if (alarmes_quadro[i] > 0) {
+            alarm_pool_cancel_alarm(pool_protocolo, alarmes_quadro[i]);
+            alarmes_quadro[i] = 0;
+            // O quadro nunca chegou ao DMA: o buffer pode voltar a receber dados
+            ocupado[i] = false;
+        }
+    }
+}
+
+void protocolo_executar_texto(void) {
+    executar_mensagem(&buffer_texto[1], (uint8_t)buffer_texto[0]);
+    __dmb();
+    texto_pendente = false;
+}
+
+void protocolo_estatisticas(EstatisticasProtocolo *copia) {
+    memcpy(copia, &estatisticas, sizeof(estatisticas));
+}
@@ -0,0 +1,71 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include "pico/stdlib.h"
+
+#include "texto.h"
+
+// Protocolo binário pela USB (CDC) para receber quadros ao vivo do PC.
+//
+// Cada pacote tem um cabeçalho de 12 bytes, todos os campos little-endian:
+//   0  'M' 'L'     marcador de início
+//   2  tipo        PACOTE_QUADRO, PACOTE_COMANDO, PACOTE_ESTATISTICAS ou PACOTE_TEXTO
+//   3  flags       PACOTE_USAR_PRAZO
+//   4  sequência   16 bits, só informativa
+//   6  tamanho     bytes do conteúdo que segue
+//   8  prazo       µs desde o início do fluxo em que o quadro deve aparecer
+// Conteúdo de PACOTE_QUADRO: NUM_PIXELS palavras de 32 bits já em GRB,
+// no mesmo formato do framebuffer (G << 24 | R << 16 | B << 8).
+// Conteúdo de PACOTE_COMANDO: uma palavra de comando (comando.h); CMD_QUADRO e
+// CMD_TEXTO são descartados, porque só o próprio protocolo os envia.
+// PACOTE_ESTATISTICAS não tem conteúdo: a resposta é o relatório de
+// telemetria.h em texto, na mesma USB.
+// Conteúdo de PACOTE_TEXTO: um byte com a velocidade em colunas por segundo
+// (0 = padrão) e a mensagem em ASCII, de 1 a TEXTO_MAX bytes sem o
+// terminador, que rola na matriz (texto.h).
+//
+// O envio fica em host/enviar_quadros.c.
+
+#define PROTOCOLO_MARCA0 'M'
+#define PROTOCOLO_MARCA1 'L'
+#define PROTOCOLO_CABECALHO 12
+
+enum {
+    PACOTE_QUADRO = 1,
+    PACOTE_COMANDO = 2,
+    PACOTE_ESTATISTICAS = 3,
+    PACOTE_TEXTO = 4
+};
+
+// Sem esta flag o quadro aparece assim que chega
+#define PACOTE_USAR_PRAZO 0x01
+
+typedef struct {
+    uint32_t quadros;      // Quadros recebidos
+    uint32_t atrasados;    // Chegaram depois do prazo
+    uint32_t descartados;  // Pacotes inválidos ou incompletos
+    uint32_t bytes;
+} EstatisticasProtocolo;
+
+// Prepara a apresentação dos quadros no núcleo de render, com o alarm pool dele
+void protocolo_init(alarm_pool_t *pool);
+
+// Lê da USB o que houver, sem bloquear quando não há nada. O conteúdo dos
+// quadros é lido direto no buffer que o DMA vai transmitir. Retorna true se
+// um quadro foi recebido e enviado ao render.
+bool protocolo_processar(void);
+
+// No núcleo de render: apresenta o quadro recebido no buffer informado,
+// agora ou no prazo dele (CMD_QUADRO)
+void protocolo_executar_quadro(uint indice);
+
+// No núcleo de render, fora dos alarmes: descarta os quadros que esperam o
+// prazo, para não cobrirem um efeito ou uma cor escolhidos depois deles
+void protocolo_cancelar_quadros(void);
+
+// No núcleo de render: começa a rolar a mensagem recebida (CMD_TEXTO)
+void protocolo_executar_texto(void);
+
+void protocolo_estatisticas(EstatisticasProtocolo *copia);
+
+#endif
@@ -0,0 +1,98 @@
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "registro.h"
+#include "hardware/sync.h"
+
+#if LIB_PICO_STDIO_USB
+#include "tusb.h"
+#endif
+
+#if (REGISTRO_CAPACIDADE & (REGISTRO_CAPACIDADE - 1)) != 0
+#error "REGISTRO_CAPACIDADE precisa ser potência de 2"
+#endif
+
+// Anel de bytes com índices que crescem livremente, como em fila.h: só o
+// produtor escreve em fim, só o consumidor em inicio
+typedef struct {
+    char dados[REGISTRO_CAPACIDADE];
+    volatile uint32_t inicio;
+    volatile uint32_t fim;
+    volatile uint32_t perdidos;
+} Anel;
+
+static Anel aneis[2];
+
+void registro(const char *formato, ...) {
+    char linha[REGISTRO_LINHA];
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(linha, sizeof(linha), formato, args);
+    va_end(args);
+    if (n <= 0) {
+        return;
+    }
+    if (n >= (int)sizeof(linha)) {
+        n = sizeof(linha) - 1;
+    }
+
+    // No mesmo núcleo o laço e as interrupções também escrevem no anel; com
+    // elas desligadas o produtor é um só, sem trava entre os núcleos
+    Anel *a = &aneis[get_core_num()];
+    uint32_t estado = save_and_disable_interrupts();
+    uint32_t fim = a->fim;
+    if (REGISTRO_CAPACIDADE - (fim - a->inicio) < (uint32_t)n) {
+        a->perdidos++;
+    } else {
+        for (int i = 0; i < n; i++) {
+            a->dados[(fim + i) & (REGISTRO_CAPACIDADE - 1)] = linha[i];
+        }
+        __dmb(); // Os bytes precisam estar visíveis antes do novo índice
+        a->fim = fim + n;
+    }
+    restore_interrupts(estado);
+}
+
+void registro_drenar(void) {
+    for (int k = 0; k < (int)count_of(aneis); k++) {
+        Anel *a = &aneis[k];
+        uint32_t inicio = a->inicio;
+        uint32_t n = a->fim - inicio;
+        if (n == 0) {
+            continue;
+        }
+        __dmb();
+
+        // Só o trecho contínuo até o fim do vetor; o resto fica para a próxima volta
+        uint32_t pos = inicio & (REGISTRO_CAPACIDADE - 1);
+        if (n > REGISTRO_CAPACIDADE - pos) {
+            n = REGISTRO_CAPACIDADE - pos;
+        }
+        if (n > REGISTRO_BYTES_POR_VOLTA) {
+            n = REGISTRO_BYTES_POR_VOLTA;
+        }
+#if LIB_PICO_STDIO_USB
+        // O stdio da USB espera por espaço quando o PC está conectado mas não
+        // lê; escrevendo só o que cabe no buffer de envio, o printf nunca para
+        uint32_t livre = tud_cdc_write_available();
+        if (n > livre) {
+            n = livre;
+        }
+        if (n == 0) {
+            return;
+        }
+#endif
+        printf("%.*s", (int)n, &a->dados[pos]);
+
+        __dmb(); // A leitura termina antes de liberar o espaço ao produtor
+        a->inicio = inicio + n;
+    }
+}
+
+bool registro_pendente(void) {
+    return aneis[0].inicio != aneis[0].fim || aneis[1].inicio != aneis[1].fim;
+}
+
+uint32_t registro_perdidos(void) {
+    return aneis[0].perdidos + aneis[1].perdidos;
+}
@@ -0,0 +1,35 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include "pico/stdlib.h"
+
+// Mensagens de log sem bloquear quem escreve. Cada núcleo tem um anel de
+// bytes próprio (um produtor, um consumidor), e o laço principal do core0
+// esvazia os anéis na USB aos poucos com registro_drenar(). Se o PC não
+// estiver lendo, as mensagens novas são descartadas e contadas, em vez de
+// travar o render ou o teclado.
+
+// Bytes de cada anel; precisa ser potência de 2
+#define REGISTRO_CAPACIDADE 2048
+
+// Tamanho máximo de uma mensagem formatada; o resto é cortado
+#define REGISTRO_LINHA 96
+
+// Bytes enviados por anel a cada chamada de registro_drenar()
+#define REGISTRO_BYTES_POR_VOLTA 64
+
+// Formata a mensagem como printf e a coloca no anel do núcleo atual. Pode ser
+// chamada de interrupções. A mensagem inteira entra ou é descartada.
+void registro(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+
+// Envia parte do que estiver nos anéis, só o que cabe no buffer de envio da
+// USB sem esperar; só no core0, fora de interrupções
+void registro_drenar(void);
+
+// Indica se ainda há mensagens esperando para sair
+bool registro_pendente(void);
+
+// Mensagens descartadas por falta de espaço desde o início
+uint32_t registro_perdidos(void);
+
+#endif
@@ -0,0 +1,389 @@
+#include <string.h>
+
+#include "reprodutor.h"
+#include "agendador.h"
+#include "buzzer.h"
+#include "compositor.h"
+#include "cor.h"
+#include "fluxo.h"
+#include "registro.h"
+#include "tela.h"
+#include "telemetria.h"
+
+// Decodificador da animação comprimida em execução e o último quadro dela.
+// É um só: duas camadas com fluxos diferentes recomeçam a decodificação a
+// cada troca, o que é correto mas mais lento.
+static Fluxo fluxo_atual;
+static const Animacao *anim_fluxo = NULL;
+static uint8_t quadro_fluxo[NUM_PIXELS];
+
+// Último quadro calculado de uma animação procedural
+static uint8_t quadro_gerado[NUM_PIXELS];
+
+// Quadros-chave da transição em andamento em cada camada e a mistura deles
+static uint8_t chave_atual[NUM_CAMADAS][NUM_PIXELS];
+static uint8_t chave_seguinte[NUM_CAMADAS][NUM_PIXELS];
+static uint8_t quadro_misturado[NUM_PIXELS];
+
+// Tempo máximo de um passo com transição; acima dele a animação volta a
+// trocar os quadros direto, sem intermediários
+#define ORCAMENTO_TRANSICAO_US (PERIODO_FPS(FPS_TRANSICAO) / 4)
+
+// Função para criar cor RGB, sem correção
+uint32_t matrix_rgb(uint8_t b, uint8_t r, uint8_t g) {
+    return ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+}
+
+// Aplica uma intensidade de 8 bits a um canal de cor (c * i / 255, sem divisão)
+static inline uint8_t escalar(uint8_t c, uint8_t i) {
+    uint32_t x = (uint32_t)c * i;
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+// Cor RGB de 8 bits com intensidade, gama e brilho aplicados, já empacotada em GRB
+static inline uint32_t cor_intensidade(uint8_t r, uint8_t g, uint8_t b, uint8_t intensidade) {
+    return cor_grb(escalar(r, intensidade), escalar(g, intensidade), escalar(b, intensidade));
+}
+
+// Desenha um quadro da animação com uma única cor na camada da tarefa
+static void desenhar_quadro(Tarefa *t, const uint8_t *intensidades, uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t *quadro = compositor_camada(t->camada);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        quadro[i] = cor_intensidade(r, g, b, intensidades[i]);
+    }
+    compositor_apresentar();
+}
+
+// Intensidades do quadro informado: da tabela, calculadas pelo gerador ou
+// decodificadas do fluxo. Os quadros de um fluxo são lidos em sequência;
+// voltar recomeça do início.
+static const uint8_t *intensidades_quadro(const Animacao *anim, int frame) {
+    if (anim->frames) {
+        return anim->frames[frame];
+    }
+    if (anim->gerador) {
+        gerador_desenhar(anim->gerador, frame, quadro_gerado);
+        return quadro_gerado;
+    }
+
+    if (anim_fluxo != anim) {
+        memset(quadro_fluxo, 0, sizeof(quadro_fluxo));
+        if (!fluxo_iniciar(&fluxo_atual, anim->fluxo, anim->tamanho_fluxo) ||
+            fluxo_atual.num_pixels > NUM_PIXELS) {
+            registro("Erro: fluxo de animação inválido.\n");
+            anim_fluxo = NULL;
+            return quadro_fluxo;
+        }
+        anim_fluxo = anim;
+    }
+    if (!fluxo_ir_para(&fluxo_atual, frame, quadro_fluxo)) {
+        registro("Erro ao decodificar o quadro %d do fluxo.\n", frame);
+    }
+    return quadro_fluxo;
+}
+
+// Depois do último quadro de uma camada acima do fundo: ela some e o que
+// está abaixo volta a aparecer inteiro
+static int64_t passo_ocultar(Tarefa *t) {
+    compositor_mostrar(t->camada, false);
+    compositor_apresentar();
+    return 0;
+}
+
+// Avança para o próximo quadro; retorna a duração do quadro desenhado em µs,
+// ou 0 no fim. O tom toca em paralelo pelo PWM e não altera essa duração.
+// O fundo termina no último quadro, que fica na matriz; as outras camadas
+// mostram o último quadro pela duração dele e depois somem.
+static int64_t proximo_quadro(Tarefa *t, int total, uint32_t duracao_us) {
+    if (++t->frame >= total) {
+        if (t->camada == CAMADA_FUNDO) {
+            return 0;
+        }
+        t->passo = passo_ocultar;
+    }
+    return duracao_us;
+}
+
+// Peso (0 a 256) do quadro-chave seguinte no quadro intermediário j de n
+static uint32_t peso_transicao(Transicao tipo, int j, int n) {
+    uint32_t w = ((uint32_t)j << 8) / n;
+    if (tipo == TRANSICAO_SUAVE) {
+        // 3w² - 2w³, com w em 8 bits fracionários
+        w = (w * w * (3 * 256 - 2 * w)) >> 16;
+    }
+    return w;
+}
+
+// Intensidades do passo atual de uma animação com transição. O primeiro
+// passo de cada quadro-chave é o próprio quadro e decide quantos
+// intermediários cabem na duração dele; os demais misturam o quadro-chave
+// com o seguinte. O último quadro-chave, ou uma animação sem transição,
+// é desenhado direto.
+static const uint8_t *intensidades_transicao(Tarefa *t) {
+    const Animacao *anim = t->anim;
+    if (anim->transicao == TRANSICAO_CORTE) {
+        return intensidades_quadro(anim, t->frame);
+    }
+
+    uint8_t *chave_atual_t = chave_atual[t->camada];
+    uint8_t *chave_seguinte_t = chave_seguinte[t->camada];
+
+    if (t->subquadro == 0) {
+        // O quadro-chave seguinte do passo anterior vira o atual, então
+        // cada quadro-chave é lido uma vez só (e os fluxos em sequência)
+        if (t->frame == 0) {
+            memcpy(chave_atual_t, intensidades_quadro(anim, 0), NUM_PIXELS);
+        } else {
+            memcpy(chave_atual_t, chave_seguinte_t, NUM_PIXELS);
+        }
+
+        t->subquadros = 1;
+        if (t->frame + 1 < anim->num_frames) {
+            memcpy(chave_seguinte_t, intensidades_quadro(anim, t->frame + 1), NUM_PIXELS);
+            if (!t->sem_transicao) {
+                t->subquadros = duracao_quadro(anim, t->frame) / PERIODO_FPS(FPS_TRANSICAO);
+                if (t->subquadros < 1) {
+                    t->subquadros = 1;
+                }
+            }
+        }
+        return chave_atual_t;
+    }
+
+    uint32_t w = peso_transicao(anim->transicao, t->subquadro, t->subquadros);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        quadro_misturado[i] = (chave_atual_t[i] * (256 - w) + chave_seguinte_t[i] * w) >> 8;
+    }
+    return quadro_misturado;
+}
+
+// Avança para o próximo passo: um intermediário por vez e, no último deles,
+// o quadro-chave seguinte. Os intermediários dividem a duração do quadro-chave
+// sem sobra, então o ritmo da animação é o mesmo sem transição. Um passo
+// que começou em inicio_us e custou mais que o orçamento desliga a transição
+// a partir do próximo quadro-chave.
+static int64_t proximo_passo(Tarefa *t, uint32_t inicio_us) {
+    const Animacao *anim = t->anim;
+    uint32_t duracao = duracao_quadro(anim, t->frame);
+    if (t->subquadros <= 1) {
+        return proximo_quadro(t, anim->num_frames, duracao);
+    }
+
+    if (time_us_32() - inicio_us > ORCAMENTO_TRANSICAO_US) {
+        t->sem_transicao = true;
+    }
+    uint32_t passo = duracao / t->subquadros;
+    if (++t->subquadro < t->subquadros) {
+        return passo;
+    }
+    t->subquadro = 0;
+    return proximo_quadro(t, anim->num_frames, duracao - passo * (t->subquadros - 1));
+}
+
+// A cor cobre a matriz inteira: vai para o fundo e as outras camadas somem
+void desenho_pio(uint8_t b, uint8_t r, uint8_t g) {
+    uint32_t *quadro = compositor_camada(CAMADA_FUNDO);
+    uint32_t valor_led = cor_grb(r, g, b);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        quadro[i] = valor_led;
+    }
+    compositor_mostrar(CAMADA_MASCARA, false);
+    compositor_mostrar(CAMADA_SOBREPOSICAO, false);
+    compositor_apresentar();
+}
+
+// Começa a tarefa na camada dela, que passa a aparecer. Um fundo novo
+// também esconde a máscara, que pertence à animação de fundo anterior.
+static void iniciar_tarefa(Tarefa t) {
+    if (t.camada == CAMADA_FUNDO) {
+        compositor_mostrar(CAMADA_MASCARA, false);
+    }
+    compositor_mostrar(t.camada, true);
+    agendador_iniciar(t);
+}
+
+static int64_t passo_animacao(Tarefa *t) {
+    uint32_t inicio_us = time_us_32();
+    const Animacao *anim = t->anim;
+    desenhar_quadro(t, intensidades_transicao(t), anim->r, anim->g, anim->b);
+
+    // O tom marca os quadros-chave, não os intermediários
+    if (t->subquadro == 0 && t->buzzer_freq > 0 && t->buzzer_duration > 0) {
+        buzzer_tone(t->buzzer_freq, t->buzzer_duration);
+    }
+    return proximo_passo(t, inicio_us);
+}
+
+void executar_animacao(const Animacao *anim, int buzzer_freq, int buzzer_duration) {
+    iniciar_tarefa((Tarefa){
+        .passo = passo_animacao,
+        .camada = CAMADA_FUNDO,
+        .anim = anim,
+        .buzzer_freq = buzzer_freq,
+        .buzzer_duration = buzzer_duration
+    });
+}
+
+// Duas cores em xadrez: as cores ficam fixas no fundo, desenhadas uma vez,
+// e as intensidades de cada quadro vão para a máscara. Como a curva gama é
+// uma potência, a cor corrigida vezes a intensidade corrigida dá a cor com
+// a intensidade aplicada antes da correção, como nas animações de uma cor.
+static int64_t passo_animacao_multicolor(Tarefa *t) {
+    uint32_t inicio_us = time_us_32();
+    const Animacao *anim = t->anim;
+    if (t->frame == 0 && t->subquadro == 0) {
+        uint32_t cores[2] = { cor_grb(anim->r, anim->g, anim->b), cor_grb(t->r2, t->g2, t->b2) };
+        Tela fundo = tela_matriz(compositor_camada(t->camada));
+        for (int y = 0; y < MATRIZ_ALTURA; y++) {
+            for (int x = 0; x < MATRIZ_LARGURA; x++) {
+                tela_pixel(&fundo, x, y, cores[(x + y) % 2]);
+            }
+        }
+        compositor_mostrar(CAMADA_MASCARA, true);
+    }
+
+    const uint8_t *intensidades = intensidades_transicao(t);
+    uint32_t *mascara = compositor_camada(CAMADA_MASCARA);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        mascara[i] = cor_gama(intensidades[i]) * 0x01010100u;
+    }
+    compositor_apresentar();
+
+    if (t->subquadro == 0 && t->buzzer_freq > 0 && t->buzzer_duration > 0) {
+        buzzer_tone(t->buzzer_freq, t->buzzer_duration);
+    }
+    return proximo_passo(t, inicio_us);
+}
+
+void executar_animacao_multicolor(const Animacao *anim, int buzzer_freq, int buzzer_duration, uint8_t r2, uint8_t g2, uint8_t b2) {
+    iniciar_tarefa((Tarefa){
+        .passo = passo_animacao_multicolor,
+        .camada = CAMADA_FUNDO,
+        .anim = anim,
+        .buzzer_freq = buzzer_freq,
+        .buzzer_duration = buzzer_duration,
+        .r2 = r2, .g2 = g2, .b2 = b2
+    });
+}
+
+// Toca um passo da linha do tempo: quadro, cor e tom vêm da tabela
+static int64_t passo_linha(Tarefa *t) {
+    const LinhaTempo *linha = t->linha;
+    const PassoLinha *passo = &linha->passos[t->frame];
+    desenhar_quadro(t, intensidades_quadro(linha->anim, passo->frame), passo->r, passo->g, passo->b);
+
+    if (passo->freq > 0) {
+        buzzer_tone(passo->freq, passo->tom_ms);
+    }
+    return proximo_quadro(t, linha->num_passos, passo->duracao_us);
+}
+
+void executar_linha(const LinhaTempo *linha) {
+    iniciar_tarefa((Tarefa){ .passo = passo_linha, .camada = CAMADA_FUNDO, .anim = linha->anim, .linha = linha });
+}
+
+// Um quadro da rolagem, na posição calculada a partir do número do quadro.
+// O tom de cada caractere toca quando a primeira coluna dele começa a
+// aparecer na borda direita.
+static int64_t passo_texto(Tarefa *t) {
+    const Texto *texto = t->texto;
+    int32_t posicao = texto_posicao(texto, t->frame);
+    Tela tela = tela_matriz(compositor_camada(t->camada));
+    texto_desenhar(texto, posicao, &tela);
+    compositor_apresentar();
+
+    if (t->frame > 0 && texto->num_estilos > 0) {
+        int32_t anterior = texto_posicao(texto, t->frame - 1);
+        for (int32_t coluna = (anterior + 255) >> 8; coluna * 256 < posicao; coluna++) {
+            int i = texto_caractere_na_coluna(texto->mensagem, coluna);
+            if (i >= 0 && texto->estilos[i % texto->num_estilos].freq > 0) {
+                buzzer_tone(texto->estilos[i % texto->num_estilos].freq, texto->tom_ms);
+            }
+        }
+    }
+    return proximo_quadro(t, texto_num_quadros(texto), PERIODO_FPS(FPS_TEXTO));
+}
+
+void executar_texto(const Texto *texto) {
+    iniciar_tarefa((Tarefa){ .passo = passo_texto, .camada = CAMADA_FUNDO, .texto = texto });
+}
+
+// Mensagem recebida em execução: fica numa cópia, com as cores em ciclo
+static char mensagem[TEXTO_MAX + 1];
+
+static const EstiloTexto estilos_mensagem[] = {
+    {255,   0,   0, 0},
+    {255, 128,   0, 0},
+    {255, 255,   0, 0},
+    {  0, 255,   0, 0},
+    {  0, 255, 255, 0},
+    {  0,   0, 255, 0},
+    {255,   0, 255, 0}
+};
+
+static Texto texto_mensagem = {
+    .mensagem = mensagem,
+    .estilos = estilos_mensagem,
+    .num_estilos = count_of(estilos_mensagem)
+};
+
+void executar_mensagem(const char *texto, uint16_t colunas_por_s) {
+    strncpy(mensagem, texto, TEXTO_MAX);
+    mensagem[TEXTO_MAX] = '\0';
+    texto_mensagem.colunas_por_s = colunas_por_s ? colunas_por_s : VELOCIDADE_MENSAGEM;
+    executar_texto(&texto_mensagem);
+}
+
+// Cada efeito é uma animação de cor única (com o tom de cada quadro), uma
+// linha do tempo ou um texto; um efeito novo é só mais uma entrada aqui
+typedef struct {
+    const Animacao *anim;
+    const LinhaTempo *linha;
+    const Texto *texto;
+    int buzzer_freq, buzzer_duration;
+} DescricaoEfeito;
+
+static const DescricaoEfeito efeitos[NUM_EFEITOS] = {
+    [EFEITO_GRADIENTE]     = { .anim = &animacao_0 },
+    [EFEITO_FADE]          = { .anim = &animacao_1 },
+    [EFEITO_PISCA]         = { .anim = &animacao_2, .buzzer_freq = 800, .buzzer_duration = 200 },
+    [EFEITO_ESPIRAL]       = { .anim = &animacao_3_espiral_LUIZ, .buzzer_freq = 800, .buzzer_duration = 200 },
+    [EFEITO_BARRAS]        = { .anim = &animacao_4, .buzzer_freq = 500, .buzzer_duration = 100 },
+    [EFEITO_LORENZO]       = { .texto = &texto_lorenzo },
+    [EFEITO_MUSICA]        = { .linha = &linha_musica },
+    [EFEITO_SIRENE]        = { .linha = &linha_sirene },
+    [EFEITO_CONTAGEM]      = { .anim = &animacao_8_countdown, .buzzer_freq = 200, .buzzer_duration = 500 },
+    [EFEITO_PERSONALIZADO] = { .anim = &animacao_9_Felipe, .buzzer_freq = 600, .buzzer_duration = 80 }
+};
+
+static void iniciar_na_camada(Efeito efeito, Camada camada) {
+    if (efeito >= NUM_EFEITOS) {
+        return;
+    }
+    const DescricaoEfeito *e = &efeitos[efeito];
+    if (e->linha) {
+        iniciar_tarefa((Tarefa){ .passo = passo_linha, .camada = camada, .anim = e->linha->anim, .linha = e->linha });
+    } else if (e->texto) {
+        iniciar_tarefa((Tarefa){ .passo = passo_texto, .camada = camada, .texto = e->texto });
+    } else {
+        iniciar_tarefa((Tarefa){
+            .passo = passo_animacao,
+            .camada = camada,
+            .anim = e->anim,
+            .buzzer_freq = e->buzzer_freq,
+            .buzzer_duration = e->buzzer_duration
+        });
+    }
+}
+
+void iniciar_efeito(Efeito efeito) {
+    // O tempo de render por efeito segue o efeito do fundo
+    if (efeito < NUM_EFEITOS) {
+        telemetria_definir_efeito(efeito);
+    }
+    iniciar_na_camada(efeito, CAMADA_FUNDO);
+}
+
+void sobrepor_efeito(Efeito efeito) {
+    iniciar_na_camada(efeito, CAMADA_SOBREPOSICAO);
+}
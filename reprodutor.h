@@ -0,0 +1,53 @@
+#ifndef REPRODUTOR_H
+#define REPRODUTOR_H
+
+#include "pico/stdlib.h"
+
+#include "animacoes.h"
+
+// Efeitos disponíveis, na ordem das teclas 0 a 9
+typedef enum {
+    EFEITO_GRADIENTE,
+    EFEITO_FADE,
+    EFEITO_PISCA,
+    EFEITO_ESPIRAL,
+    EFEITO_BARRAS,
+    EFEITO_LORENZO,
+    EFEITO_MUSICA,
+    EFEITO_SIRENE,
+    EFEITO_CONTAGEM,
+    EFEITO_PERSONALIZADO,
+    NUM_EFEITOS
+} Efeito;
+
+// Função para criar cor RGB. Só empacota em GRB: a correção de gama e o
+// brilho (cor.h) são aplicados por desenho_pio e pelas animações.
+uint32_t matrix_rgb(uint8_t b, uint8_t r, uint8_t g);
+
+// Desenha um padrão de cor única na matriz de LEDs, cobrindo todas as camadas
+void desenho_pio(uint8_t b, uint8_t r, uint8_t g);
+
+// As funções abaixo só iniciam a animação no agendador e retornam na hora;
+// os quadros seguintes são desenhados pelos alarmes.
+void executar_animacao(const Animacao *anim, int buzzer_freq, int buzzer_duration);
+void executar_animacao_multicolor(const Animacao *anim, int buzzer_freq, int buzzer_duration, uint8_t r2, uint8_t g2, uint8_t b2);
+void executar_linha(const LinhaTempo *linha);
+void executar_texto(const Texto *texto);
+
+// Velocidade, em colunas por segundo, das mensagens recebidas sem uma
+#ifndef VELOCIDADE_MENSAGEM
+#define VELOCIDADE_MENSAGEM 10
+#endif
+
+// Rola uma mensagem qualquer (até TEXTO_MAX caracteres, copiada) com as
+// cores do arco-íris em ciclo; colunas_por_s 0 usa VELOCIDADE_MENSAGEM
+void executar_mensagem(const char *texto, uint16_t colunas_por_s);
+
+// Inicia o efeito com os parâmetros (cores, buzzer) de cada tecla, no fundo
+void iniciar_efeito(Efeito efeito);
+
+// Inicia o efeito na camada de sobreposição (compositor.h), somado por cima
+// do fundo sem interrompê-lo; a camada some quando o efeito termina
+void sobrepor_efeito(Efeito efeito);
+
+#endif
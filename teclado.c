@@ -0,0 +1,104 @@
+#include <stdio.h>
+
+#include "teclado.h"
+#include "fila.h"
+#include "matriz_led.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+
+// Arquivo .pio
+#include "teclado.pio.h"
+
+// O programa .pio aciona as linhas como bits de um grupo de 5 pinos a partir
+// de ROW4 (GPIO 6); ROW1-ROW3 e ROW4 são os bits 4, 3, 2 e 0
+#define PINO_BASE_LINHAS ROW4
+#define MASCARA_LINHAS ((1u << (ROW1 - ROW4)) | (1u << (ROW2 - ROW4)) | (1u << (ROW3 - ROW4)) | 1u)
+
+// As colunas são lidas como 4 pinos consecutivos a partir de COL4 (GPIO 2)
+#define PINO_BASE_COLUNAS COL4
+
+// Evento na fila: bit 8 indica tecla pressionada, bits 0-7 a tecla
+#define EVENTO_PRESSIONADA (1u << 8)
+
+static const char keys[16] = {
+    '1', '2', '3', 'A',
+    '4', '5', '6', 'B',
+    '7', '8', '9', 'C',
+    '*', '0', '#', 'D'
+};
+
+static PIO pio_teclado;
+static uint sm_teclado;
+static uint16_t estado_anterior = 0xFFFF; // Ativo em nível baixo: todas soltas
+
+FILA_DEFINIR(fila_eventos, 32);
+
+// A tecla da linha i e coluna j fica no bit 15 - (4 * i + j) do estado
+static void tratar_irq_teclado(void) {
+    while (!pio_sm_is_rx_fifo_empty(pio_teclado, sm_teclado)) {
+        uint16_t estado = pio_sm_get(pio_teclado, sm_teclado);
+        uint16_t mudancas = estado ^ estado_anterior;
+        estado_anterior = estado;
+
+        for (int k = 0; k < 16; k++) {
+            uint16_t bit = 1u << (15 - k);
+            if (mudancas & bit) {
+                uint32_t evento = (uint8_t)keys[k];
+                if (!(estado & bit)) {
+                    evento |= EVENTO_PRESSIONADA;
+                }
+                // Com a fila cheia o evento é descartado
+                fila_inserir(&fila_eventos, evento);
+            }
+        }
+    }
+}
+
+void teclado_init(PIO pio) {
+    pio_teclado = pio;
+
+    int offset = pio_add_program(pio, &teclado_program);
+    if (offset < 0) {
+        printf("Erro ao carregar programa PIO do teclado.\n");
+        return;
+    }
+
+    int sm = pio_claim_unused_sm(pio, true);
+    if (sm < 0) {
+        printf("Erro ao requisitar state machine do teclado.\n");
+        return;
+    }
+    sm_teclado = sm;
+
+    teclado_program_init(pio, sm_teclado, offset, PINO_BASE_LINHAS, MASCARA_LINHAS, PINO_BASE_COLUNAS);
+
+    // Interrupção sempre que a state machine reporta um novo estado
+    uint irq = (pio == pio0) ? PIO0_IRQ_0 : PIO1_IRQ_0;
+    irq_set_exclusive_handler(irq, tratar_irq_teclado);
+    pio_set_irq0_source_enabled(pio, pis_sm0_rx_fifo_not_empty + sm_teclado, true);
+    irq_set_enabled(irq, true);
+}
+
+bool teclado_obter_evento(EventoTecla *evento) {
+    uint32_t valor;
+    if (!fila_remover(&fila_eventos, &valor)) {
+        return false;
+    }
+    evento->tecla = (char)(valor & 0xFF);
+    evento->pressionada = (valor & EVENTO_PRESSIONADA) != 0;
+    return true;
+}
+
+bool teclado_pendente(void) {
+    return !fila_vazia(&fila_eventos);
+}
+
+char detect_key(void) {
+    EventoTecla evento;
+    while (teclado_obter_evento(&evento)) {
+        if (evento.pressionada) {
+            return evento.tecla;
+        }
+    }
+    return '\0';
+}
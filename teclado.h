@@ -0,0 +1,27 @@
+#ifndef TECLADO_H
+#define TECLADO_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Evento gerado pela varredura do teclado
+typedef struct {
+    char tecla;
+    bool pressionada; // false = tecla solta
+} EventoTecla;
+
+// Carrega o programa de varredura no PIO informado e liga a interrupção
+// que converte os estados da FIFO RX em eventos de tecla
+void teclado_init(PIO pio);
+
+// Retira o próximo evento da fila; retorna false se não houver nenhum
+bool teclado_obter_evento(EventoTecla *evento);
+
+// Indica se há eventos na fila, sem retirá-los
+bool teclado_pendente(void);
+
+// Função para detectar tecla pressionada.
+// Não bloqueia: retorna a próxima tecla pressionada da fila ou '\0'.
+char detect_key(void);
+
+#endif
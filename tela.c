@@ -0,0 +1,48 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "tela.h"
+
+void tela_preencher(Tela *tela, uint32_t cor) {
+    int n = tela->largura * tela->altura;
+    for (int i = 0; i < n; i++) {
+        tela->pixels[i] = cor;
+    }
+}
+
+// Bresenham, só com somas inteiras
+void tela_linha(Tela *tela, int x0, int y0, int x1, int y1, uint32_t cor) {
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int erro = dx + dy;
+    while (true) {
+        tela_pixel(tela, x0, y0, cor);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * erro;
+        if (e2 >= dy) {
+            erro += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            erro += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void tela_copiar(Tela *tela, int x, int y, const uint32_t *imagem, int largura, int altura) {
+    // Recorta o retângulo uma vez e copia cada linha de uma vez
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + largura > tela->largura ? tela->largura : x + largura;
+    int y1 = y + altura > tela->altura ? tela->altura : y + altura;
+    if (x0 >= x1) {
+        return;
+    }
+    for (int ty = y0; ty < y1; ty++) {
+        memcpy(&tela->pixels[ty * tela->largura + x0], &imagem[(ty - y) * largura + (x0 - x)],
+               (x1 - x0) * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include "pico/stdlib.h"
+
+#include "layout.h"
+
+// Imagem de cores GRB em coordenadas (x, y), guardada linha a linha a
+// partir do canto superior esquerdo, sem relação com a ordem dos LEDs
+// (layout.h). As primitivas recortam o que cai fora da tela, então um
+// desenho pode passar das bordas.
+typedef struct {
+    uint32_t *pixels;
+    int largura, altura;
+} Tela;
+
+// Tela do tamanho da matriz sobre um buffer de NUM_PIXELS, como as camadas
+// do compositor
+static inline Tela tela_matriz(uint32_t *pixels) {
+    return (Tela){ pixels, MATRIZ_LARGURA, MATRIZ_ALTURA };
+}
+
+static inline void tela_pixel(Tela *tela, int x, int y, uint32_t cor) {
+    if ((uint)x < (uint)tela->largura && (uint)y < (uint)tela->altura) {
+        tela->pixels[y * tela->largura + x] = cor;
+    }
+}
+
+// Cor do pixel, ou 0 fora da tela
+static inline uint32_t tela_ler(const Tela *tela, int x, int y) {
+    if ((uint)x < (uint)tela->largura && (uint)y < (uint)tela->altura) {
+        return tela->pixels[y * tela->largura + x];
+    }
+    return 0;
+}
+
+void tela_preencher(Tela *tela, uint32_t cor);
+
+// Segmento de (x0, y0) a (x1, y1), com as duas pontas
+void tela_linha(Tela *tela, int x0, int y0, int x1, int y1, uint32_t cor);
+
+// Copia uma imagem de largura x altura, linha a linha, com o canto superior
+// esquerdo em (x, y)
+void tela_copiar(Tela *tela, int x, int y, const uint32_t *imagem, int largura, int altura);
+
+#endif
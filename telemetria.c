@@ -0,0 +1,148 @@
+#include <string.h>
+
+#include "telemetria.h"
+#include "agendador.h"
+#include "framebuffer.h"
+#include "protocolo.h"
+#include "registro.h"
+#include "hardware/sync.h"
+
+static Telemetria telemetria;
+static volatile Efeito efeito_atual = EFEITO_GRADIENTE;
+
+// Tecla pendente: o core0 escreve o instante e depois a flag; o render lê
+// nessa ordem e limpa a flag
+static volatile uint32_t instante_tecla;
+static volatile bool tecla_pendente = false;
+
+static const char *const nomes_efeitos[NUM_EFEITOS] = {
+    "gradiente", "fade", "pisca", "espiral", "barras",
+    "lorenzo", "musica", "sirene", "contagem", "personalizado"
+};
+
+void telemetria_medir(Medida *m, uint32_t inicio_us) {
+    uint32_t duracao = time_us_32() - inicio_us;
+    m->amostras++;
+    m->soma_us += duracao;
+    if (duracao > m->max_us) {
+        m->max_us = duracao;
+    }
+}
+
+void telemetria_definir_efeito(Efeito efeito) {
+    if (efeito < NUM_EFEITOS) {
+        efeito_atual = efeito;
+    }
+}
+
+void telemetria_render(uint32_t inicio_us) {
+    telemetria_medir(&telemetria.render[efeito_atual], inicio_us);
+}
+
+void telemetria_espera_fifo(uint32_t inicio_us) {
+    telemetria_medir(&telemetria.espera_fifo, inicio_us);
+}
+
+void telemetria_buzzer(uint32_t inicio_us) {
+    telemetria_medir(&telemetria.buzzer, inicio_us);
+}
+
+void telemetria_ocioso(uint32_t inicio_us) {
+    telemetria_medir(&telemetria.ocioso[get_core_num()], inicio_us);
+}
+
+void telemetria_marcar_tecla(void) {
+    instante_tecla = time_us_32();
+    __dmb();
+    tecla_pendente = true;
+}
+
+void telemetria_quadro_apresentado(void) {
+    if (!tecla_pendente) {
+        return;
+    }
+    __dmb();
+    uint32_t inicio_us = instante_tecla;
+    tecla_pendente = false;
+    telemetria_medir(&telemetria.latencia_tecla, inicio_us);
+}
+
+void telemetria_copiar(Telemetria *copia) {
+    memcpy(copia, &telemetria, sizeof(telemetria));
+}
+
+void telemetria_zerar(void) {
+    memset(&telemetria, 0, sizeof(telemetria));
+    telemetria.inicio_us = time_us_64();
+}
+
+static void relatorio_medida(const char *nome, const Medida *m) {
+    uint32_t media = m->amostras ? (uint32_t)(m->soma_us / m->amostras) : 0;
+    registro("%-14s %8lu x  média %6lu µs  máx %6lu µs\n", nome,
+             (unsigned long)m->amostras, (unsigned long)media, (unsigned long)m->max_us);
+}
+
+// Utilização e residência em repouso de um núcleo na janela, em décimos de %
+static void relatorio_nucleo(int nucleo, const Medida *ocioso, uint64_t janela_us) {
+    uint32_t ocioso_pm = janela_us ? (uint32_t)(ocioso->soma_us * 1000 / janela_us) : 0;
+    if (ocioso_pm > 1000) {
+        ocioso_pm = 1000;
+    }
+    uint32_t ocupado_pm = 1000 - ocioso_pm;
+    registro("core%d: %lu.%lu%% ocupado, %lu.%lu%% dormindo, %lu despertares, sono máx %lu µs\n",
+             nucleo, (unsigned long)(ocupado_pm / 10), (unsigned long)(ocupado_pm % 10),
+             (unsigned long)(ocioso_pm / 10), (unsigned long)(ocioso_pm % 10),
+             (unsigned long)ocioso->amostras, (unsigned long)ocioso->max_us);
+}
+
+// Uma linha por faixa do histograma de atraso dos passos do agendador
+static void relatorio_faixas(const EstatisticasQuadro *agenda) {
+    static const uint32_t limites[AGENDADOR_FAIXAS - 1] = AGENDADOR_LIMITES_FAIXAS;
+    for (int f = 0; f < AGENDADOR_FAIXAS - 1; f++) {
+        registro("  atraso ≤%4lu µs: %lu\n", (unsigned long)limites[f], (unsigned long)agenda->faixas[f]);
+    }
+    registro("  atraso >%4lu µs: %lu\n", (unsigned long)limites[AGENDADOR_FAIXAS - 2],
+             (unsigned long)agenda->faixas[AGENDADOR_FAIXAS - 1]);
+}
+
+void telemetria_relatorio(void) {
+    Telemetria t;
+    EstatisticasQuadro agenda;
+    EstatisticasFramebuffer quadros;
+    EstatisticasProtocolo usb;
+    telemetria_copiar(&t);
+    agendador_estatisticas(&agenda);
+    framebuffer_estatisticas(&quadros);
+    protocolo_estatisticas(&usb);
+
+    uint64_t janela_us = time_us_64() - t.inicio_us;
+    registro("== stats (%lu ms desde o último relatório) ==\n", (unsigned long)(janela_us / 1000));
+    for (int e = 0; e < NUM_EFEITOS; e++) {
+        if (t.render[e].amostras) {
+            relatorio_medida(nomes_efeitos[e], &t.render[e]);
+        }
+    }
+    relatorio_medida("espera fifo", &t.espera_fifo);
+    relatorio_medida("buzzer", &t.buzzer);
+    relatorio_medida("tecla->quadro", &t.latencia_tecla);
+    relatorio_nucleo(0, &t.ocioso[0], janela_us);
+#if MATRIZ_DUAL_CORE
+    relatorio_nucleo(1, &t.ocioso[1], janela_us);
+#endif
+    registro("prazos: %lu passos, %lu estouros, atraso máx %lu µs\n",
+             (unsigned long)agenda.quadros, (unsigned long)agenda.estouros,
+             (unsigned long)agenda.atraso_max_us);
+    relatorio_faixas(&agenda);
+    registro("quadros: %lu enviados, %lu repetidos\n",
+             (unsigned long)quadros.enviados, (unsigned long)quadros.repetidos);
+    registro("usb: %lu quadros, %lu atrasados, %lu descartados\n",
+             (unsigned long)usb.quadros, (unsigned long)usb.atrasados,
+             (unsigned long)usb.descartados);
+    registro("registro: %lu mensagens perdidas\n", (unsigned long)registro_perdidos());
+
+    // Cada relatório cobre só o intervalo desde o anterior, para uma piora
+    // aparecer nos números em vez de se diluir na média desde o boot
+    telemetria_zerar();
+    agendador_zerar_estatisticas();
+    framebuffer_zerar_estatisticas();
+}
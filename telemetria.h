@@ -0,0 +1,58 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include "pico/stdlib.h"
+
+#include "reprodutor.h"
+
+// Contadores de desempenho em tempo de execução, baratos o bastante para
+// ficarem sempre ligados: cada medida é uma leitura do timer no início e
+// outra no fim. Os contadores do render são escritos só pelo núcleo de
+// render; o relatório é montado no core0 e pode pegar uma medida no meio.
+
+// Tempo de uma operação repetida, em µs
+typedef struct {
+    uint32_t amostras;
+    uint32_t max_us;
+    uint64_t soma_us;
+} Medida;
+
+typedef struct {
+    Medida render[NUM_EFEITOS]; // Passo completo de cada efeito no agendador
+    Medida espera_fifo;         // Espera pelo fim da transmissão anterior
+    Medida buzzer;              // Configuração do PWM de cada tom
+    Medida latencia_tecla;      // Da tecla detectada ao próximo quadro apresentado
+    Medida ocioso[2];           // Cada período dormindo em __wfi/__wfe, por núcleo
+    uint64_t inicio_us;         // Início da janela dos contadores (último zerar)
+} Telemetria;
+
+// Registra o tempo decorrido desde inicio_us (time_us_32)
+void telemetria_medir(Medida *m, uint32_t inicio_us);
+
+// Efeito a que os próximos passos do agendador pertencem
+void telemetria_definir_efeito(Efeito efeito);
+
+// Passo do agendador que começou em inicio_us
+void telemetria_render(uint32_t inicio_us);
+
+void telemetria_espera_fifo(uint32_t inicio_us);
+void telemetria_buzzer(uint32_t inicio_us);
+
+// Período ocioso do núcleo atual, que dormiu de inicio_us até agora. A
+// utilização da CPU no relatório é o que sobra do tempo da janela.
+void telemetria_ocioso(uint32_t inicio_us);
+
+// Marca o instante de uma tecla; o próximo quadro apresentado fecha a medida
+void telemetria_marcar_tecla(void);
+void telemetria_quadro_apresentado(void);
+
+void telemetria_copiar(Telemetria *copia);
+void telemetria_zerar(void);
+
+// Escreve no registro (registro.h) todos os contadores: os daqui, os do
+// agendador, do framebuffer e do protocolo. Não bloqueia. Depois zera os
+// daqui, os do agendador e os do framebuffer; os do protocolo e do registro
+// continuam contando desde o boot.
+void telemetria_relatorio(void);
+
+#endif
@@ -0,0 +1,176 @@
+#include "texto.h"
+#include "cor.h"
+#include "layout.h"
+
+// Colunas de espaço em branco de um caractere sem desenho na fonte
+#define LARGURA_ESPACO 2
+
+// Tamanho dos desenhos da fonte
+#define LARGURA_FONTE 5
+#define ALTURA_FONTE 5
+
+#define PRIMEIRO_GLIFO ' '
+#define ULTIMO_GLIFO 'Z'
+
+// Fonte 5x5: uma linha por byte, de cima para baixo, com a coluna da
+// esquerda no bit 4. Os desenhos ficam encostados à esquerda e a largura de
+// cada caractere vai até a última coluna acesa.
+static const uint8_t fonte[ULTIMO_GLIFO - PRIMEIRO_GLIFO + 1][ALTURA_FONTE] = {
+    ['!' - ' '] = { 0b10000, 0b10000, 0b10000, 0b00000, 0b10000 },
+    ['\'' - ' '] = { 0b10000, 0b10000, 0b00000, 0b00000, 0b00000 },
+    ['+' - ' '] = { 0b00000, 0b01000, 0b11100, 0b01000, 0b00000 },
+    [',' - ' '] = { 0b00000, 0b00000, 0b00000, 0b01000, 0b10000 },
+    ['-' - ' '] = { 0b00000, 0b00000, 0b11100, 0b00000, 0b00000 },
+    ['.' - ' '] = { 0b00000, 0b00000, 0b00000, 0b00000, 0b10000 },
+    ['0' - ' '] = { 0b01100, 0b10110, 0b11010, 0b10010, 0b01100 },
+    ['1' - ' '] = { 0b01000, 0b11000, 0b01000, 0b01000, 0b11100 },
+    ['2' - ' '] = { 0b11100, 0b00010, 0b01100, 0b10000, 0b11110 },
+    ['3' - ' '] = { 0b11100, 0b00010, 0b01100, 0b00010, 0b11100 },
+    ['4' - ' '] = { 0b10010, 0b10010, 0b11110, 0b00010, 0b00010 },
+    ['5' - ' '] = { 0b11110, 0b10000, 0b11100, 0b00010, 0b11100 },
+    ['6' - ' '] = { 0b01100, 0b10000, 0b11100, 0b10010, 0b01100 },
+    ['7' - ' '] = { 0b11110, 0b00010, 0b00100, 0b01000, 0b01000 },
+    ['8' - ' '] = { 0b01100, 0b10010, 0b01100, 0b10010, 0b01100 },
+    ['9' - ' '] = { 0b01100, 0b10010, 0b01110, 0b00010, 0b01100 },
+    [':' - ' '] = { 0b00000, 0b10000, 0b00000, 0b10000, 0b00000 },
+    ['?' - ' '] = { 0b11100, 0b00010, 0b01100, 0b00000, 0b01000 },
+    ['A' - ' '] = { 0b01100, 0b10010, 0b11110, 0b10010, 0b10010 },
+    ['B' - ' '] = { 0b11100, 0b10010, 0b11100, 0b10010, 0b11100 },
+    ['C' - ' '] = { 0b01110, 0b10000, 0b10000, 0b10000, 0b01110 },
+    ['D' - ' '] = { 0b11100, 0b10010, 0b10010, 0b10010, 0b11100 },
+    ['E' - ' '] = { 0b11110, 0b10000, 0b11100, 0b10000, 0b11110 },
+    ['F' - ' '] = { 0b11110, 0b10000, 0b11100, 0b10000, 0b10000 },
+    ['G' - ' '] = { 0b01110, 0b10000, 0b10110, 0b10010, 0b01110 },
+    ['H' - ' '] = { 0b10010, 0b10010, 0b11110, 0b10010, 0b10010 },
+    ['I' - ' '] = { 0b11100, 0b01000, 0b01000, 0b01000, 0b11100 },
+    ['J' - ' '] = { 0b00110, 0b00010, 0b00010, 0b10010, 0b01100 },
+    ['K' - ' '] = { 0b10010, 0b10100, 0b11000, 0b10100, 0b10010 },
+    ['L' - ' '] = { 0b10000, 0b10000, 0b10000, 0b10000, 0b11110 },
+    ['M' - ' '] = { 0b10001, 0b11011, 0b10101, 0b10001, 0b10001 },
+    ['N' - ' '] = { 0b10001, 0b11001, 0b10101, 0b10011, 0b10001 },
+    ['O' - ' '] = { 0b01100, 0b10010, 0b10010, 0b10010, 0b01100 },
+    ['P' - ' '] = { 0b11100, 0b10010, 0b11100, 0b10000, 0b10000 },
+    ['Q' - ' '] = { 0b01100, 0b10010, 0b10010, 0b10100, 0b01010 },
+    ['R' - ' '] = { 0b11100, 0b10010, 0b11100, 0b10100, 0b10010 },
+    ['S' - ' '] = { 0b01110, 0b10000, 0b01100, 0b00010, 0b11100 },
+    ['T' - ' '] = { 0b11111, 0b00100, 0b00100, 0b00100, 0b00100 },
+    ['U' - ' '] = { 0b10010, 0b10010, 0b10010, 0b10010, 0b01100 },
+    ['V' - ' '] = { 0b10001, 0b10001, 0b10001, 0b01010, 0b00100 },
+    ['W' - ' '] = { 0b10001, 0b10001, 0b10101, 0b11011, 0b10001 },
+    ['X' - ' '] = { 0b10001, 0b01010, 0b00100, 0b01010, 0b10001 },
+    ['Y' - ' '] = { 0b10001, 0b01010, 0b00100, 0b00100, 0b00100 },
+    ['Z' - ' '] = { 0b11110, 0b00010, 0b01100, 0b10000, 0b11110 }
+};
+
+static const EstiloTexto estilo_branco = { 255, 255, 255, 0 };
+
+static const uint8_t *glifo(char c) {
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+    }
+    if (c < PRIMEIRO_GLIFO || c > ULTIMO_GLIFO) {
+        c = ' ';
+    }
+    return fonte[c - PRIMEIRO_GLIFO];
+}
+
+static int largura_glifo(const uint8_t *g) {
+    uint8_t colunas = 0;
+    for (int y = 0; y < ALTURA_FONTE; y++) {
+        colunas |= g[y];
+    }
+    if (colunas == 0) {
+        return LARGURA_ESPACO;
+    }
+    int largura = LARGURA_FONTE;
+    while (!(colunas & 1)) {
+        colunas >>= 1;
+        largura--;
+    }
+    return largura;
+}
+
+// Coluna c do caractere, com a linha y no bit y; linhas abaixo da fonte
+// ficam apagadas
+static uint8_t coluna_glifo(const uint8_t *g, int c) {
+    uint8_t bits = 0;
+    for (int y = 0; y < ALTURA_FONTE; y++) {
+        bits |= ((g[y] >> (LARGURA_FONTE - 1 - c)) & 1) << y;
+    }
+    return bits;
+}
+
+static const EstiloTexto *estilo_caractere(const Texto *texto, int i) {
+    return texto->num_estilos > 0 ? &texto->estilos[i % texto->num_estilos] : &estilo_branco;
+}
+
+int texto_largura(const char *mensagem) {
+    int largura = 0;
+    for (; *mensagem; mensagem++) {
+        largura += largura_glifo(glifo(*mensagem)) + 1;
+    }
+    return largura;
+}
+
+int texto_caractere_na_coluna(const char *mensagem, int coluna) {
+    int inicio = 0;
+    for (int i = 0; mensagem[i] && inicio <= coluna; i++) {
+        if (inicio == coluna) {
+            return i;
+        }
+        inicio += largura_glifo(glifo(mensagem[i])) + 1;
+    }
+    return -1;
+}
+
+static uint32_t velocidade(const Texto *texto) {
+    return texto->colunas_por_s > 0 ? texto->colunas_por_s : 1;
+}
+
+int32_t texto_posicao(const Texto *texto, uint32_t frame) {
+    return (int32_t)(((uint64_t)frame * velocidade(texto) * 256) / FPS_TEXTO);
+}
+
+int texto_num_quadros(const Texto *texto) {
+    // O último quadro já é o primeiro com a matriz vazia
+    uint32_t colunas = texto_largura(texto->mensagem) + MATRIZ_LARGURA;
+    return (colunas * FPS_TEXTO + velocidade(texto) - 1) / velocidade(texto) + 1;
+}
+
+void texto_desenhar(const Texto *texto, int32_t posicao, Tela *tela) {
+    // Coluna da mensagem sob o LED x = 0 e quanto a seguinte já entrou nele
+    int primeira = (posicao >> 8) - MATRIZ_LARGURA;
+    uint32_t fracao = posicao & 0xFF;
+
+    // Colunas da mensagem vistas na matriz, uma a mais para a mistura
+    uint8_t bits[MATRIZ_LARGURA + 1] = { 0 };
+    const EstiloTexto *estilos[MATRIZ_LARGURA + 1];
+    for (int j = 0; j <= MATRIZ_LARGURA; j++) {
+        estilos[j] = &estilo_branco;
+    }
+    int inicio = 0;
+    for (int i = 0; texto->mensagem[i] && inicio <= primeira + MATRIZ_LARGURA; i++) {
+        const uint8_t *g = glifo(texto->mensagem[i]);
+        int largura = largura_glifo(g);
+        for (int c = 0; c < largura; c++) {
+            int j = inicio + c - primeira;
+            if (j >= 0 && j <= MATRIZ_LARGURA) {
+                bits[j] = coluna_glifo(g, c);
+                estilos[j] = estilo_caractere(texto, i);
+            }
+        }
+        inicio += largura + 1;
+    }
+
+    tela_preencher(tela, 0);
+    for (int x = 0; x < MATRIZ_LARGURA; x++) {
+        const EstiloTexto *a = estilos[x], *b = estilos[x + 1];
+        for (int y = 0; y < MATRIZ_ALTURA; y++) {
+            uint32_t wa = ((bits[x] >> y) & 1) ? 256 - fracao : 0;
+            uint32_t wb = ((bits[x + 1] >> y) & 1) ? fracao : 0;
+            tela_pixel(tela, x, y, cor_grb((a->r * wa + b->r * wb) >> 8,
+                                           (a->g * wa + b->g * wb) >> 8,
+                                           (a->b * wa + b->b * wb) >> 8));
+        }
+    }
+}
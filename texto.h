@@ -0,0 +1,56 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include "pico/stdlib.h"
+
+#include "tela.h"
+
+// Texto rolando na matriz, desenhado na hora a partir de uma fonte 5x5 de
+// 5 bytes por caractere: uma mensagem custa só os próprios caracteres.
+// A fonte é proporcional (I tem 3 colunas, M tem 5) e cada caractere é
+// seguido de uma coluna vazia. Minúsculas saem como maiúsculas; caracteres
+// fora da fonte saem como espaço.
+
+// Taxa dos quadros da rolagem
+#ifndef FPS_TEXTO
+#define FPS_TEXTO 60
+#endif
+
+// Tamanho máximo de uma mensagem recebida em execução (protocolo.h)
+#define TEXTO_MAX 64
+
+// Cor de um caractere e o tom que toca quando ele entra na matriz
+typedef struct {
+    uint8_t r, g, b;
+    uint16_t freq;  // Hz; 0 = sem som
+} EstiloTexto;
+
+// Mensagem que entra pela direita e sai pela esquerda. Os estilos valem um
+// por caractere, repetidos em ciclo; sem estilos o texto sai branco.
+typedef struct {
+    const char *mensagem;
+    const EstiloTexto *estilos;
+    int num_estilos;
+    uint16_t colunas_por_s; // Velocidade da rolagem
+    uint16_t tom_ms;        // Duração dos tons dos estilos
+} Texto;
+
+// Largura da mensagem em colunas, com o espaço depois de cada caractere
+int texto_largura(const char *mensagem);
+
+// Índice do caractere que começa na coluna informada da mensagem, ou -1
+int texto_caractere_na_coluna(const char *mensagem, int coluna);
+
+// Posição da rolagem (em 1/256 de coluna) no quadro informado
+int32_t texto_posicao(const Texto *texto, uint32_t frame);
+
+// Número de quadros até a mensagem sair inteira da matriz
+int texto_num_quadros(const Texto *texto);
+
+// Desenha a mensagem na tela, do tamanho da matriz, com a rolagem
+// informada: na posição 0 o texto está logo à direita da matriz. Posições
+// entre duas colunas misturam as duas, então a rolagem anda menos de uma
+// coluna por quadro sem saltos.
+void texto_desenhar(const Texto *texto, int32_t posicao, Tela *tela);
+
+#endif